@@ -136,8 +136,37 @@ namespace lsp
             static constexpr float  FREQ_BOOST_MAX          = 20000.0f;
 
             static constexpr size_t REFRESH_RATE            = 20;
+            static constexpr size_t REFRESH_RATE_MIN        = 2;        // Refresh rate when the displayed data is static [Hz]
+            static constexpr float  REFRESH_ACTIVITY_LOW    = 1.0116f;  // Level change considered static between refreshes (0.1 dB)
+            static constexpr float  REFRESH_ACTIVITY_HIGH   = 1.1220f;  // Level change that requires the maximum refresh rate (1 dB)
             static constexpr float  PROT_SHUTDOWN_TIME      = 400.0f;
             static constexpr float  PROT_ATTACK_MUL         = 2.0f;
+            static constexpr float  BYPASS_FADE_TIME        = 5.0f;     // Cross-fade time of the bypass switch [ms]
+            static constexpr float  SNAPSHOT_PRIME_MUL      = 3.0f;     // Detector priming time in units of attack and reactivity time
+            static constexpr size_t TASK_WAIT_TIME          = 1000;     // Time to wait for a queued background task on destroy [ms]
+            static constexpr float  BYPASS_WARM_UP_TIME     = 20.0f;    // Additional warm-up time after resuming processing [ms]
+            static constexpr size_t BLOCK_SIZE_MIN          = 0x100;    // Minimum size of internal processing block [samples]
+            static constexpr size_t BLOCK_SIZE_MAX          = 0x1000;   // Maximum size of internal processing block [samples]
+            static constexpr float  BLOCK_SIZE_WINDOW       = 2.0f;     // Time window for tracking the host buffer size [s]
+            static constexpr size_t VCA_BUS_SIZE            = 0x4000;   // Size of the shared VCA ring buffer of each band [samples]
+            static constexpr float  VCA_XFADE_TIME          = 10.0f;    // Cross-fade time between own and leader's VCA of the follower [ms]
+            static constexpr float  VCA_HOLD_TIME           = 250.0f;   // Time the follower holds the leader's VCA while own detection warms up [ms]
+
+            static constexpr size_t GR_HISTORY_POINTS       = 256;      // Number of points in the gain reduction history mesh, power of 2
+            static constexpr size_t GR_HISTORY_DECIM        = 64;       // Number of samples in the cell of the first history level
+            static constexpr size_t GR_HISTORY_LEVELS       = 7;        // Number of levels of the gain reduction history pyramid
+            static constexpr size_t RECORDER_FRAMES         = 0x400;    // Number of processing blocks kept by the flight recorder
+            static constexpr size_t STATS_SLOTS             = 256;      // Number of instance slots in the statistics segment
+
+            static constexpr float  GR_HISTORY_TIME_MIN     = 0.5f;
+            static constexpr float  GR_HISTORY_TIME_MAX     = 20.0f;
+            static constexpr float  GR_HISTORY_TIME_DFL     = 5.0f;
+            static constexpr float  GR_HISTORY_TIME_STEP    = 0.005f;
+
+            static constexpr size_t VCA_GROUP_MIN           = 1;
+            static constexpr size_t VCA_GROUP_MAX           = 8;
+            static constexpr size_t VCA_GROUP_DFL           = 1;
+            static constexpr size_t VCA_GROUP_STEP          = 1;
 
             static constexpr size_t FFT_XOVER_RANK_MIN      = 12;
             static constexpr size_t FFT_XOVER_FREQ_MIN      = 44100;
@@ -22,6 +22,7 @@
 #ifndef PRIVATE_PLUGINS_GOTT_COMPRESSOR_H_
 #define PRIVATE_PLUGINS_GOTT_COMPRESSOR_H_
 
+#include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/dsp-units/ctl/Bypass.h>
 #include <lsp-plug.in/dsp-units/ctl/Counter.h>
 #include <lsp-plug.in/dsp-units/dynamics/DynamicProcessor.h>
@@ -30,9 +31,12 @@
 #include <lsp-plug.in/dsp-units/filters/Equalizer.h>
 #include <lsp-plug.in/dsp-units/filters/Filter.h>
 #include <lsp-plug.in/dsp-units/util/Analyzer.h>
-#include <lsp-plug.in/dsp-units/util/Delay.h>
 #include <lsp-plug.in/dsp-units/util/FFTCrossover.h>
 #include <lsp-plug.in/dsp-units/util/Sidechain.h>
+#include <lsp-plug.in/ipc/ITask.h>
+#include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/ipc/SharedMem.h>
+#include <lsp-plug.in/runtime/system.h>
 #include <lsp-plug.in/plug-fw/core/IDBuffer.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 
@@ -56,6 +60,66 @@ namespace lsp
                     GOTT_MS
                 };
 
+                // Header of the statistics segment, followed by STATS_SLOTS slots
+                typedef struct stats_header_t
+                {
+                    uint32_t            nMagic;                 // Magic number
+                    uint32_t            nVersion;               // Layout version
+                    uint32_t            nSlots;                 // Number of slots
+                    uint32_t            nSlotSize;              // Size of the slot in bytes
+                } stats_header_t;
+
+                // Statistics of one instance. The slot is consistent when nSerial is even and
+                // has not changed while reading. The slot is used while nOwner is odd, each new
+                // owner gets the next generation
+                typedef struct stats_slot_t
+                {
+                    uint32_t            nSerial;                // Write serial, odd while the slot is updated
+                    uint32_t            nOwner;                 // Owner token: generation of the slot, odd if used
+                    uint32_t            nPid;                   // Process of the owner
+                    uint32_t            nStamp;                 // Time of the last update by the owner [s]
+                    uint32_t            nMode;                  // Processor mode
+                    uint32_t            nXOver;                 // Crossover mode
+                    uint32_t            nChannels;              // Number of channels
+                    uint32_t            nBands;                 // Number of bands
+                    uint32_t            nSampleRate;            // Sample rate
+                    uint32_t            nBlocks;                // Number of processed host blocks
+                    uint32_t            nOverloads;             // Number of host blocks processed longer than their duration
+                    float               fDspTime;               // DSP time of the last host block [us]
+                    float               fDspTimeMax;            // Maximum DSP time of a host block [us]
+                    float               fLoad;                  // DSP time relative to the duration of the last host block
+                    float               fLoadMax;               // Maximum DSP time relative to the duration of a host block
+                    float               vInLevel[2];            // Input peak level
+                    float               vOutLevel[2];           // Output peak level
+                    float               vGain[2][meta::gott_compressor::BANDS_MAX];     // Band gain (reduction) level
+                    float               vCurve[2][meta::gott_compressor::BANDS_MAX];    // Band curve level
+                } stats_slot_t;
+
+                // Flight recorder frame, one per processing block
+                typedef struct rec_frame_t
+                {
+                    uint32_t            nSamples;               // Number of samples in the block
+                    float               fProt;                  // Minimum gain of the surge protector
+                    float               vIn[2];                 // Input peak level
+                    float               vOut[2];                // Output peak level
+                    float               vEnv[2][meta::gott_compressor::BANDS_MAX];      // Band envelope peak level
+                    float               vVCAMin[2][meta::gott_compressor::BANDS_MAX];   // Band minimum VCA gain
+                    float               vVCAMax[2][meta::gott_compressor::BANDS_MAX];   // Band maximum VCA gain
+                } rec_frame_t;
+
+                // Header of the flight recorder file, followed by nFrames frames in chronological order
+                typedef struct rec_header_t
+                {
+                    uint32_t            nMagic;                 // Magic number
+                    uint32_t            nVersion;               // Layout version
+                    uint32_t            nFrameSize;             // Size of the frame in bytes
+                    uint32_t            nChannels;              // Number of channels
+                    uint32_t            nBands;                 // Number of bands
+                    uint32_t            nSampleRate;            // Sample rate
+                    uint32_t            nHead;                  // Number of recorded frames, the last frame in the file is nHead-1
+                    uint32_t            nFrames;                // Number of frames in the file
+                } rec_header_t;
+
             protected:
                 enum sync_t
                 {
@@ -80,6 +144,202 @@ namespace lsp
                     SCT_LINK
                 };
 
+                enum vca_share_t
+                {
+                    VCA_SHARE_OFF,
+                    VCA_SHARE_LEADER,
+                    VCA_SHARE_FOLLOWER
+                };
+
+                typedef void (gott_compressor::*process_block_t)(size_t samples);
+
+                typedef struct vca_bus_t
+                {
+                    gott_compressor    *pLeader;                // Instance that publishes the VCA, NULL if none
+                    uint32_t            nGroup;                 // Number of the detector sharing group
+                    uint32_t            nRefs;                  // Number of instances using the bus
+                    uint32_t            nHead;                  // Number of published samples (wraps around)
+                    uint32_t            nSerial;                // Serial of the format fields, odd while the leader updates them
+                    uint32_t            nSampleRate;            // Sample rate of the leader
+                    uint32_t            nChannels;              // Number of channels of the leader
+                    uint32_t            nBands;                 // Number of bands of the leader
+                    float               vVCA[2][meta::gott_compressor::BANDS_MAX][meta::gott_compressor::VCA_BUS_SIZE];  // Ring buffers
+                } vca_bus_t;
+
+                typedef struct freq_grid_t
+                {
+                    float               vFreqs[meta::gott_compressor::FFT_MESH_POINTS];     // Frequencies
+                    uint32_t            vIndexes[meta::gott_compressor::FFT_MESH_POINTS];   // Analyzer FFT indexes
+                    size_t              nSampleRate;            // Sample rate
+                    size_t              nRefs;                  // Number of references
+                    freq_grid_t        *pNext;                  // Next grid in the list
+                } freq_grid_t;
+
+                enum bypass_state_t
+                {
+                    BYP_ACTIVE,                                 // Processing is active, bypass is off or fading out
+                    BYP_FADE_OUT,                               // Processing is active, cross-fade to the dry signal
+                    BYP_SUSPENDED,                              // Processing is suspended, only the dry signal passes
+                    BYP_WARM_UP                                 // Processing is resumed, bypass is on until the warm-up completes
+                };
+
+                enum delay_lane_t
+                {
+                    DL_MAIN,                                    // Input signal after applying input gain
+                    DL_DRY,                                     // Unprocessed input signal
+                    DL_SC,                                      // Sidechain signal
+
+                    DL_TOTAL
+                };
+
+                typedef struct delay_line_t
+                {
+                    float              *vLane[DL_TOTAL];        // Ring buffer for each lane
+                    size_t              vSize[DL_TOTAL];        // Size of ring buffer for each lane
+                    size_t              vHead[DL_TOTAL];        // Write position for each lane
+                    size_t              nLookahead;             // Lookahead tap
+                    size_t              nXOver;                 // Crossover latency tap
+                } delay_line_t;
+
+                // Header of the binary state snapshot, followed by the channel records
+                typedef struct snapshot_header_t
+                {
+                    uint32_t            nMagic;                 // Magic number
+                    uint32_t            nVersion;               // Layout version
+                    uint32_t            nSize;                  // Total size of the snapshot in bytes
+                    uint32_t            nSampleRate;            // Sample rate
+                    uint32_t            nMode;                  // Processor mode
+                    uint32_t            nXOver;                 // Crossover mode
+                    uint32_t            nChannels;              // Number of channels
+                    uint32_t            nBands;                 // Number of bands
+                    uint32_t            nBypassState;           // Bypass state
+                    uint32_t            nBypassCounter;         // Number of samples before the next bypass state transition
+                    float               fOldDryGain;            // Dry gain applied to the last block
+                    float               fOldWetGain;            // Wet gain applied to the last block
+                } snapshot_header_t;
+
+                // Channel record of the snapshot, followed by the contents of the delay lanes
+                typedef struct snapshot_channel_t
+                {
+                    uint32_t            vSize[DL_TOTAL];        // Size of each delay lane
+                    uint32_t            vHead[DL_TOTAL];        // Write position of each delay lane
+                    float               vGainLevel[meta::gott_compressor::BANDS_MAX];   // Measured gain adjustment level
+                    float               vEnvLevel[meta::gott_compressor::BANDS_MAX];    // Envelope level of the last block
+                } snapshot_channel_t;
+
+                typedef struct xover_state_t
+                {
+                    dspu::FFTCrossover *vXOver[2];              // FFT crossovers, allocated only for linear phase mode
+                    uint8_t            *pDelayData;             // Memory for delay lines
+                    size_t              nDataSize;              // Size of allocated memory
+                    size_t              vLaneSize[DL_TOTAL];    // Size of each delay lane
+                    size_t              nSampleRate;            // Sample rate the state was allocated for
+                    bool                bLinear;                // The state can serve linear phase mode
+                } xover_state_t;
+
+                typedef struct block_state_t
+                {
+                    uint8_t            *pData;                  // Memory for buffers of the processing block
+                    size_t              nDataSize;              // Size of allocated memory
+                    size_t              nBlockSize;             // Capacity of each buffer [samples]
+                } block_state_t;
+
+                // Background task that works on the plugin data and can be cancelled
+                // while it is still queued in the executor
+                class CoreTask: public ipc::ITask
+                {
+                    protected:
+                        gott_compressor    *pCore;
+                        atomic_t            nState;
+
+                    protected:
+                        bool                enter();
+                        void                leave();
+
+                    public:
+                        explicit CoreTask(gott_compressor *core);
+                        CoreTask(const CoreTask &) = delete;
+                        CoreTask(CoreTask &&) = delete;
+                        virtual ~CoreTask() override;
+
+                        CoreTask & operator = (const CoreTask &) = delete;
+                        CoreTask & operator = (CoreTask &&) = delete;
+
+                    public:
+                        bool                cancel();
+                        bool                cancelled() const;
+                        bool                busy() const;
+                };
+
+                class XOverLoader: public CoreTask
+                {
+                    public:
+                        explicit XOverLoader(gott_compressor *core);
+                        XOverLoader(const XOverLoader &) = delete;
+                        XOverLoader(XOverLoader &&) = delete;
+                        virtual ~XOverLoader() override;
+
+                        XOverLoader & operator = (const XOverLoader &) = delete;
+                        XOverLoader & operator = (XOverLoader &&) = delete;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
+                class BlockLoader: public CoreTask
+                {
+                    public:
+                        explicit BlockLoader(gott_compressor *core);
+                        BlockLoader(const BlockLoader &) = delete;
+                        BlockLoader(BlockLoader &&) = delete;
+                        virtual ~BlockLoader() override;
+
+                        BlockLoader & operator = (const BlockLoader &) = delete;
+                        BlockLoader & operator = (BlockLoader &&) = delete;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
+                class VcaLoader: public CoreTask
+                {
+                    public:
+                        explicit VcaLoader(gott_compressor *core);
+                        VcaLoader(const VcaLoader &) = delete;
+                        VcaLoader(VcaLoader &&) = delete;
+                        virtual ~VcaLoader() override;
+
+                        VcaLoader & operator = (const VcaLoader &) = delete;
+                        VcaLoader & operator = (VcaLoader &&) = delete;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
+                class AnalyzerLoader: public CoreTask
+                {
+                    public:
+                        explicit AnalyzerLoader(gott_compressor *core);
+                        AnalyzerLoader(const AnalyzerLoader &) = delete;
+                        AnalyzerLoader(AnalyzerLoader &&) = delete;
+                        virtual ~AnalyzerLoader() override;
+
+                        AnalyzerLoader & operator = (const AnalyzerLoader &) = delete;
+                        AnalyzerLoader & operator = (AnalyzerLoader &&) = delete;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
+                enum premix_bus_t
+                {
+                    PM_IN,                                      // Input bus
+                    PM_SC,                                      // Sidechain bus
+                    PM_LINK,                                    // Shared memory link bus
+
+                    PM_TOTAL
+                };
+
                 typedef struct premix_t
                 {
                     float               fInToSc;                // Input -> Sidechain mix
@@ -89,6 +349,9 @@ namespace lsp
                     float               fScToIn;                // Sidechain -> Input mix
                     float               fScToLink;              // Sidechain -> Link mix
 
+                    float               vMatrix[PM_TOTAL][PM_TOTAL];    // Mixing matrix [destination][source]
+                    uint32_t            vMask[PM_TOTAL];        // Mask of non-zero sources for each destination
+
                     float              *vIn[2];                 // Input buffer
                     float              *vOut[2];                // Output buffer
                     float              *vSc[2];                 // Sidechain buffer
@@ -106,18 +369,79 @@ namespace lsp
                     plug::IPort        *pScToLink;              // Sidechain -> Link mix
                 } premix_t;
 
+                typedef struct band_ports_t
+                {
+                    plug::IPort            *pMinThresh;         // Minimum threshold
+                    plug::IPort            *pUpThresh;          // Upward threshold
+                    plug::IPort            *pDownThresh;        // Downward threshold
+                    plug::IPort            *pUpRatio;           // Upward ratio
+                    plug::IPort            *pDownRatio;         // Downward ratio
+                    plug::IPort            *pKnee;              // Knee
+                    plug::IPort            *pAttackTime;        // Attack time
+                    plug::IPort            *pReleaseTime;       // Release time
+                    plug::IPort            *pMakeup;            // Makeup gain
+
+                    plug::IPort            *pEnabled;           // Enabled flag
+                    plug::IPort            *pSolo;              // Solo channel
+                    plug::IPort            *pMute;              // Mute channel
+                    plug::IPort            *pCurveMesh;         // Curve mesh
+                    plug::IPort            *pFreqMesh;          // Filter frequencymesh
+                    plug::IPort            *pEnvLvl;            // Envelope level meter
+                    plug::IPort            *pCurveLvl;          // Reduction curve level meter
+                    plug::IPort            *pMeterGain;         // Reduction gain meter
+                } band_ports_t;
+
+                typedef struct grh_level_t
+                {
+                    float                  *vMin;               // Ring buffer of cell minimums
+                    float                  *vMax;               // Ring buffer of cell maximums
+                    float                   fMin;               // Minimum of the accumulated cell
+                    float                   fMax;               // Maximum of the accumulated cell
+                    uint32_t                nCount;             // Number of accumulated samples (first level) or cells
+                    uint32_t                nHead;              // Number of written cells (wraps around)
+                } grh_level_t;
+
+                typedef struct idisplay_cache_t
+                {
+                    const float            *vFreqs;             // Frequency grid the mapping has been computed for
+                    uint32_t                nWidth;             // Width of the cached layout, 0 if not valid
+                    uint32_t                nHeight;            // Height of the cached layout
+                    float                   fZoom;              // Zoom of the cached layout
+                    uint32_t                nGridX;             // Number of vertical grid lines
+                    uint32_t                nGridY;             // Number of horizontal grid lines
+                    float                   vGridX[4];          // Positions of vertical grid lines
+                    float                   vGridY[12];         // Positions of horizontal grid lines
+                    float                   fZy;                // Vertical axis zero
+                    float                   fDy;                // Vertical axis scale
+                } idisplay_cache_t;
+
+                // State of the band accessed for each processed block. States of all bands of
+                // the channel are stored contiguously and are not interleaved with DSP modules
+                typedef struct band_vca_t
+                {
+                    float                  *vBuffer;            // Crossover band data (linear phase mode only)
+                    float                  *vVCA;               // Voltage-controlled amplification value for each band
+                    float                  *vLeader;            // VCA received from the leader of the detector sharing group
+                    float                   fVcaHold;           // Last VCA value received from the leader
+                    float                   fMakeup;            // Makeup gain
+                    float                   fGainLevel;         // Measured gain adjustment level
+                    uint32_t                nFilterID;          // Filter ID in dynamic filters
+                    bool                    bEnabled;           // Enabled flag
+                    bool                    bMute;              // Mute channel
+                } band_vca_t;
+
                 typedef struct band_t
                 {
+                    // DSP modules accessed for each processed block
                     dspu::Sidechain         sSC;                // Sidechain module
                     dspu::Equalizer         sEQ[2];             // Sidechain equalizers
                     dspu::DynamicProcessor  sProc;              // Dynamic Processor
                     dspu::Filter            sPassFilter;        // Passing filter for 'classic' mode
                     dspu::Filter            sRejFilter;         // Rejection filter for 'classic' mode
                     dspu::Filter            sAllFilter;         // All-pass filter for phase compensation
+                    grh_level_t             vHistory[meta::gott_compressor::GR_HISTORY_LEVELS]; // Gain reduction history pyramid
 
-                    float                  *vBuffer;            // Crossover band data
-                    float                  *vVCA;               // Voltage-controlled amplification value for each band
-                    float                  *vCurveBuffer;       // Compression curve
+                    // State accessed only when settings or meshes are updated
                     float                  *vFilterBuffer;      // Bandpass Filter Buffer
                     float                  *vSidechainBuffer;   // Band Sidechain Filter buffer
 
@@ -126,34 +450,16 @@ namespace lsp
                     float                   fDownThresh;        // Downward threshold
                     float                   fUpRatio;           // Upward ratio
                     float                   fDownRatio;         // Downward ratio
+                    float                   fKnee;              // Knee
                     float                   fAttackTime;        // Attack time
                     float                   fReleaseTime;       // Release time
-                    float                   fMakeup;            // Makeup gain
-                    float                   fGainLevel;         // Measured gain adjustment level
+                    float                   fRefreshGain;       // Gain level at the last refresh
                     uint32_t                nSync;              // Mesh synchronization flags
-                    uint32_t                nFilterID;          // Filter ID in dynamic filters
-                    bool                    bEnabled;           // Enabled flag
                     bool                    bSolo;              // Solo channel
-                    bool                    bMute;              // Mute channel
-
-                    plug::IPort            *pMinThresh;         // Minimum threshold
-                    plug::IPort            *pUpThresh;          // Upward threshold
-                    plug::IPort            *pDownThresh;        // Downward threshold
-                    plug::IPort            *pUpRatio;           // Upward ratio
-                    plug::IPort            *pDownRatio;         // Downward ratio
-                    plug::IPort            *pKnee;              // Knee
-                    plug::IPort            *pAttackTime;        // Attack time
-                    plug::IPort            *pReleaseTime;       // Release time
-                    plug::IPort            *pMakeup;            // Makeup gain
+                    bool                    bMuteSw;            // State of the mute switch
+                    bool                    bDirty;             // Settings of the band have changed on last update
 
-                    plug::IPort            *pEnabled;           // Enabled flag
-                    plug::IPort            *pSolo;              // Solo channel
-                    plug::IPort            *pMute;              // Mute channel
-                    plug::IPort            *pCurveMesh;         // Curve mesh
-                    plug::IPort            *pFreqMesh;          // Filter frequencymesh
-                    plug::IPort            *pEnvLvl;            // Envelope level meter
-                    plug::IPort            *pCurveLvl;          // Reduction curve level meter
-                    plug::IPort            *pMeterGain;         // Reduction gain meter
+                    band_ports_t           *pPorts;             // Ports of the band
                 } band_t;
 
                 typedef struct channel_t
@@ -161,14 +467,12 @@ namespace lsp
                     dspu::Bypass            sBypass;            // Bypass
                     dspu::Filter            sEnvBoost[2];       // Envelope boost filter
                     dspu::Equalizer         sDryEq;             // Dry equalizer
-                    dspu::FFTCrossover      sFFTXOver;          // FFT crossover for linear phase
-                    dspu::Delay             sDelay;             // Lookahead Delay
-                    dspu::Delay             sDryDelay;          // Delay for dry signal
-                    dspu::Delay             sAnDelay;           // Delay for analyzer
-                    dspu::Delay             sScDelay;           // Delay for sidechain
-                    dspu::Delay             sXOverDelay;        // Delay for crossover
+                    dspu::FFTCrossover     *pFFTXOver;          // FFT crossover for linear phase (if allocated)
+                    delay_line_t            sDelay;             // Multi-tap delay line
 
+                    band_vca_t              vVca[meta::gott_compressor::BANDS_MAX];
                     band_t                  vBands[meta::gott_compressor::BANDS_MAX];
+                    band_ports_t            vBandPorts[meta::gott_compressor::BANDS_MAX];
 
                     float                  *vIn;                // Input data buffer
                     float                  *vOut;               // Output data buffer
@@ -178,14 +482,17 @@ namespace lsp
                     float                  *vBuffer;            // Temporary buffer
                     float                  *vScBuffer;          // Sidechain buffer
                     float                  *vInAnalyze;         // Input signal analysis
-                    float                  *vTmpFilterBuffer;   // Filter transfer function of the channel (temporary)
                     float                  *vFilterBuffer;      // Filter transfer function of the channel
+                    float                   vAmpGain[meta::gott_compressor::BANDS_MAX]; // Band gain levels of the computed transfer function
 
                     uint32_t                nAnInChannel;       // Analyzer channel used for input signal analysis
                     uint32_t                nAnOutChannel;      // Analyzer channel used for output signal analysis
                     bool                    bInFft;             // Input signal FFT enabled
                     bool                    bOutFft;            // Output signal FFT enabled
                     bool                    bRebuildFilers;     // Rebuild filter configuration
+                    bool                    bAmpSync;           // Transfer function has been computed but not published
+                    float                   fRefreshIn;         // Input level at the last refresh
+                    float                   fRefreshOut;        // Output level at the last refresh
 
                     plug::IPort            *pIn;                // Input
                     plug::IPort            *pOut;               // Output
@@ -196,6 +503,7 @@ namespace lsp
                     plug::IPort            *pFftIn;             // Pre-processing FFT analysis data
                     plug::IPort            *pFftOut;            // Post-processing FFT analysis data
                     plug::IPort            *pAmpGraph;          // Amplitude graph
+                    plug::IPort            *pGrHistory;         // Gain reduction history graph
                     plug::IPort            *pInLvl;             // Input level meter
                     plug::IPort            *pOutLvl;            // Output level meter
                 } channel_t;
@@ -212,16 +520,51 @@ namespace lsp
                 uint32_t                nBands;                 // Number of bands
                 xover_mode_t            enXOver;                // Crossover mode
                 uint32_t                nScType;                // Sidechain type
+                process_block_t         pProcessBlock;          // Block processing function for current crossover mode and sidechain type
+                size_t                  nBlockSize;             // Maximum size of internal processing block
+                size_t                  nHostBlock;             // Maximum size of host buffer in the last window
+                size_t                  nHostPeak;              // Maximum size of host buffer in the current window
+                size_t                  nHostTime;              // Number of samples processed in the current window
+                uint32_t                nScMode;                // Sidechain mode
+                uint32_t                nScSource;              // Sidechain source
+                float                   fScReact;               // Sidechain reactivity
+                float                   fMaxAttack;             // Maximum attack time of all bands
                 bool                    bSidechain;             // External side chain
                 bool                    bProt;                  // Surge protection enabled
                 bool                    bEnvUpdate;             // Envelope filter update
                 bool                    bStereoSplit;           // Stereo split mode
+                uint32_t                nVcaShare;              // Detector sharing mode
+                vca_bus_t              *pVcaBus;                // Bus of the detector sharing group
+                vca_bus_t              *pVcaBusNew;             // Bus acquired by the loader
+                vca_bus_t              *pVcaBusGarbage;         // Bus to be released by the loader
+                VcaLoader              *pVcaLoader;             // Loader of the detector sharing bus
+                uint32_t                nVcaGroup;              // Requested detector sharing group, 0 if none
+                uint32_t                nVcaGroupNew;           // Detector sharing group requested from the loader
+                uint32_t                nVcaTail;               // Number of samples read from the bus by the follower
+                uint32_t                nVcaHold;               // Samples left to hold the leader's VCA after the leader is lost
+                float                   fVcaMix;                // Weight of the leader's VCA in the VCA of the follower
+                bool                    bVcaLeader;             // The instance is the leader of the group
+                bool                    bVcaSync;               // The follower is synchronized with the leader
+                stats_slot_t           *pStats;                 // Slot in the statistics segment, NULL if disabled
+                uint32_t                nStatsOwner;            // Owner token of the statistics slot
+                rec_frame_t            *vRecFrames;             // Flight recorder frames
+                uint32_t                nRecHead;               // Number of recorded frames (wraps around)
+                uint32_t                nBypassState;           // Bypass state
+                uint32_t                nBypassCounter;         // Number of samples before the next bypass state transition
                 float                   fInGain;                // Input gain adjustment
                 float                   fDryGain;               // Dry gain
                 float                   fWetGain;               // Wet gain
+                float                   fOldDryGain;            // Dry gain applied to the previous block
+                float                   fOldWetGain;            // Wet gain applied to the previous block
+                uint32_t                nDryHold;               // Number of samples to keep the re-enabled dry chain muted
+                uint32_t                nWetHold;               // Number of samples to keep the re-enabled wet chain muted
+                bool                    bDryOn;                 // Dry chain has been computed for the previous block
+                bool                    bWetOn;                 // Wet chain has been computed for the previous block
                 float                   fScPreamp;              // Sidechain pre-amplification
                 uint32_t                nEnvBoost;              // Envelope boost
                 float                   fZoom;                  // Zoom value
+                float                   fGrTime;                // Gain reduction history time
+                float                   fRefreshRate;           // Current refresh rate of the meshes and inline display
                 float                   vSplits[meta::gott_compressor::BANDS_MAX - 1];  // Split frequencies
                 channel_t              *vChannels;              // Processor channels
                 float                  *vAnalyze[4];            // Analysis buffer
@@ -233,10 +576,15 @@ namespace lsp
                 float                  *vTr;                    // Transfer buffer
                 float                  *vPFc;                   // Pass filter characteristics buffer
                 float                  *vRFc;                   // Reject filter characteristics buffer
-                float                  *vCurveBuffer;           // Compression curve (input values)
-                float                  *vFreqBuffer;            // Frequencies (input values)
-                uint32_t               *vFreqIndexes;           // Analyzer FFT indexes
+                float                  *vTmpFilter;             // Filter transfer function of the channel (temporary)
+                const float            *vCurveBuffer;           // Compression curve (input values), shared by all instances
+                float                  *vFreqBuffer;            // Frequencies (input values), shared by instances with the same sample rate
+                uint32_t               *vFreqIndexes;           // Analyzer FFT indexes, shared by instances with the same sample rate
+                freq_grid_t            *pFreqGrid;              // Shared frequency grid
                 core::IDBuffer         *pIDisplay;              // Inline display buffer
+                idisplay_cache_t        sIDisplay;              // Cached layout of the inline display
+                bool                    bIDisplaySync;          // Inline display needs to be redrawn
+                bool                    bIDisplayBypass;        // Bypass state of the last requested redraw
 
                 plug::IPort            *pBypass;                // Bypass port
                 plug::IPort            *pMode;                  // Global mode
@@ -255,23 +603,110 @@ namespace lsp
                 plug::IPort            *pReactivity;            // Reactivity
                 plug::IPort            *pShiftGain;             // Shift gain port
                 plug::IPort            *pZoom;                  // Zoom port
+                plug::IPort            *pGrTime;                // Gain reduction history time
                 plug::IPort            *pEnvBoost;              // Envelope adjust
                 plug::IPort            *pSplits[meta::gott_compressor::BANDS_MAX - 1];  // Split frequencies
                 plug::IPort            *pExtraBand;             // Extra band enable
                 plug::IPort            *pScType;                // Sidechain type
                 plug::IPort            *pStereoSplit;           // Stereo split mode
+                plug::IPort            *pVcaShare;              // Detector sharing mode
+                plug::IPort            *pVcaGroup;              // Detector sharing group
 
                 uint8_t                *pData;                  // Aligned data pointer
+                size_t                  nDataSize;              // Size of allocated data
+                xover_state_t           sXOver;                 // Active linear phase state and delay lines
+                xover_state_t           sXOverNew;              // State prepared by the loader
+                xover_state_t           sXOverGarbage;          // State to be freed by the loader
+                XOverLoader            *pXOverLoader;           // Loader of linear phase state
+                block_state_t           sBlock;                 // Active buffers of the processing block
+                block_state_t           sBlockNew;              // Buffers prepared by the loader
+                block_state_t           sBlockGarbage;          // Buffers to be freed by the loader
+                BlockLoader            *pBlockLoader;           // Loader of processing block buffers
+                AnalyzerLoader         *pAnLoader;              // Loader of the analyzer
+                bool                    bAnalyzer;              // Analyzer is initialized
+                bool                    bAnRequest;             // Analyzer has been requested by the UI
+
+            protected:
+                static ipc::Mutex                   sSharedLock;            // Lock for the data shared between instances
+                static freq_grid_t                 *pFreqGrids;             // List of shared frequency grids
+                static vca_bus_t                   *vVcaBuses[meta::gott_compressor::VCA_GROUP_MAX];    // Detector sharing buses, allocated on demand
+                static ipc::SharedMem              *pStatsShm;              // Statistics segment
+                static size_t                       nStatsRefs;             // Number of instances using the statistics segment
+                static atomic_t                     nInstances;             // Number of instances in the process
+                static thread_local uint32_t        nRtDepth;               // Nesting depth of real-time sections of the current thread
+                static atomic_t                     nRtViolations;          // Number of non-RT-safe calls made from real-time sections
 
             protected:
                 static dspu::sidechain_source_t     decode_sidechain_source(int source, bool split, size_t channel);
+                static const float                 *curve_grid();
+                static freq_grid_t                 *acquire_freq_grid(size_t sr);
+                static void                         release_freq_grid(freq_grid_t *grid);
+                static stats_slot_t                *acquire_stats_slot(uint32_t *owner);
+                static void                         release_stats_slot(stats_slot_t *slot, uint32_t owner);
+                static bool                         stats_slot_stale(const stats_slot_t *slot, uint32_t now, bool expired);
+                static vca_bus_t                   *acquire_vca_bus(size_t group);
+                static void                         release_vca_bus(vca_bus_t *bus);
+                static bool                         read_vca_format(const vca_bus_t *bus, uint32_t *sample_rate, uint32_t *channels, uint32_t *bands);
                 static size_t                       select_fft_rank(size_t sample_rate);
+                static size_t                       select_block_size(size_t host_block);
                 static void                         process_band(void *object, void *subject, size_t band, const float *data, size_t sample, size_t count);
+                static void                         delay_write(delay_line_t *dl, size_t lane, const float *src, size_t count);
+                static void                         delay_read(const delay_line_t *dl, size_t lane, float *dst, size_t delay, size_t count);
+                static void                         delay_clear(delay_line_t *dl, size_t lane, size_t count);
+                static void                         history_push(grh_level_t *levels, const float *src, size_t count);
+                static void                         history_fetch(const grh_level_t *levels, float *min, float *max, size_t level, size_t cells, size_t points);
+                static void                         init_xover_state(xover_state_t *st);
+                static void                         free_xover_state(xover_state_t *st);
+                static void                         dump_xover_state(dspu::IStateDumper *v, const char *name, const xover_state_t *st);
+                static void                         init_block_state(block_state_t *st);
+                static void                         free_block_state(block_state_t *st);
+                static void                         dump_block_state(dspu::IStateDumper *v, const char *name, const block_state_t *st);
+                static process_block_t              select_process_block(uint32_t xover, uint32_t sct);
+                static float                        refresh_budget();
+                static void                         rt_check();
+                static bool                         wait_task(CoreTask *task);
 
             protected:
                 uint32_t            decode_sidechain_type(uint32_t sc) const;
+                void                process_premix(size_t samples);
+                template <uint32_t SCT>
                 void                process_sidechain(size_t samples);
+                template <uint32_t XOVER, uint32_t SCT>
+                void                process_block(size_t samples);
+                void                process_input(size_t samples);
+                void                process_output(size_t samples, float dry_gain, float wet_gain);
+                void                process_suspended(size_t samples);
+                void                update_bypass_state(size_t samples);
                 void                update_premix();
+                bool                update_xover_mode();
+                void                update_analyzer();
+                void                update_filters();
+                void                update_latency(size_t lookahead);
+                void                update_vca_share();
+                void                leave_vca_bus();
+                void                sync_vca_bus();
+                void                vca_bus_publish();
+                bool                vca_bus_fetch(size_t samples);
+                void                vca_bus_write(size_t channel, size_t band, const float *src, size_t samples);
+                void                vca_bus_commit(size_t samples);
+                bool                vca_bus_read(size_t samples);
+                void                publish_stats(size_t samples, const system::time_t *start);
+                void                update_refresh_rate();
+                void                update_idisplay_mapping(size_t width);
+                void                update_idisplay_grid(size_t height);
+                bool                init_analyzer();
+                void                sync_analyzer();
+                bool                alloc_xover_state(xover_state_t *st, size_t sr, bool linear);
+                void                apply_xover_state(xover_state_t *st);
+                void                sync_xover_state();
+                bool                alloc_block_state(block_state_t *st, size_t block);
+                void                apply_block_state(block_state_t *st);
+                void                sync_block_state(size_t samples);
+                size_t              collect_recorder(rec_frame_t *dst, uint32_t *head) const;
+                void                dump_recorder(dspu::IStateDumper *v) const;
+                void                prime_detectors(const float *env);
+                size_t              bypass_fade_samples() const;
+                size_t              warm_up_samples() const;
                 void                do_destroy();
 
             public:
@@ -293,6 +728,22 @@ namespace lsp
                 virtual void        process(size_t samples) override;
                 virtual bool        inline_display(plug::ICanvas *cv, size_t width, size_t height) override;
                 virtual void        dump(dspu::IStateDumper *v) const override;
+
+            public:
+                // Clone the state into another instance with the same configuration. The snapshot holds
+                // the delay lines, the band gain and envelope levels and the bypass state. Memories of the
+                // filters, FFT crossover and surge protector are not accessible and start from silence.
+                // Neither call may run concurrently with process(), restore_snapshot() primes the detectors
+                // and must not be called from the audio thread
+                size_t              snapshot_size() const;
+                size_t              save_snapshot(void *dst, size_t size) const;
+                status_t            restore_snapshot(const void *src, size_t size);
+
+                // Write the flight recorder to the file, must not be called from the audio thread
+                status_t            save_recorder(const char *path) const;
+
+            public:
+                static bool         read_stats_slot(const stats_slot_t *slot, stats_slot_t *dst, size_t attempts);
         };
 
     } /* namespace plugins */
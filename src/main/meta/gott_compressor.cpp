@@ -26,7 +26,7 @@
 
 #define LSP_PLUGINS_GOTT_COMPRESSOR_VERSION_MAJOR       1
 #define LSP_PLUGINS_GOTT_COMPRESSOR_VERSION_MINOR       0
-#define LSP_PLUGINS_GOTT_COMPRESSOR_VERSION_MICRO       20
+#define LSP_PLUGINS_GOTT_COMPRESSOR_VERSION_MICRO       21
 
 #define LSP_PLUGINS_GOTT_COMPRESSOR_VERSION  \
     LSP_MODULE_VERSION( \
@@ -120,6 +120,14 @@ namespace lsp
             { NULL, NULL }
         };
 
+        static const port_item_t gott_vca_share[] =
+        {
+            { "Off",            "gott_comp.vca.off"         },
+            { "Leader",         "gott_comp.vca.leader"      },
+            { "Follower",       "gott_comp.vca.follower"    },
+            { NULL, NULL }
+        };
+
         #define GOTT_SHM_LINK_MONO \
             OPT_RETURN_MONO("link", "shml", "Side-chain shared memory link")
 
@@ -162,13 +170,19 @@ namespace lsp
             AMP_GAIN10("sc2in", "Sidechain to Input mix", "SC to In mix", GAIN_AMP_M_INF_DB), \
             AMP_GAIN10("sc2lk", "Sidechain to Link mix", "SC to Link mix", GAIN_AMP_M_INF_DB)
 
+        #define GOTT_VCA_SHARE \
+            COMBO("vca", "Detector sharing mode", "VCA share", 0, gott_vca_share), \
+            INT_CONTROL("vca_grp", "Detector sharing group", "VCA group", U_NONE, gott_compressor::VCA_GROUP)
+
         #define GOTT_COMMON \
             GOTT_BASE, \
-            COMBO("sc_ext", "External sidechain source", "Ext SC source", 0, gott_sc_source)
+            COMBO("sc_ext", "External sidechain source", "Ext SC source", 0, gott_sc_source), \
+            GOTT_VCA_SHARE
 
         #define GOTT_SC_COMMON \
             GOTT_BASE, \
-            COMBO("sc_ext", "External sidechain source", "Ext SC source", 0, gott_sc_source_for_sc)
+            COMBO("sc_ext", "External sidechain source", "Ext SC source", 0, gott_sc_source_for_sc), \
+            GOTT_VCA_SHARE
 
         #define GOTT_SPLIT_COMMON \
             SWITCH("ssplit", "Stereo split", "Stereo split", 0.0f), \
@@ -183,8 +197,12 @@ namespace lsp
             MESH("ifg" id, "Input FFT graph" label, 2, gott_compressor::FFT_MESH_POINTS + 2), \
             MESH("ofg" id, "Output FFT graph" label, 2, gott_compressor::FFT_MESH_POINTS)
 
+        #define GOTT_GR_HISTORY \
+            LOG_CONTROL("grht", "Gain reduction history time", "GR history", U_SEC, gott_compressor::GR_HISTORY_TIME)
+
         #define GOTT_AMP_CURVE(id, label) \
-            MESH("ag" id, "Compressor amplitude graph " label, 2, gott_compressor::FFT_MESH_POINTS)
+            MESH("ag" id, "Compressor amplitude graph " label, 2, gott_compressor::FFT_MESH_POINTS), \
+            MESH("grh" id, "Gain reduction history graph " label, 1 + gott_compressor::BANDS_MAX * 2, gott_compressor::GR_HISTORY_POINTS)
 
         #define GOTT_METERS(id, label) \
             METER_GAIN("ilm" id, "Input level meter" label, GAIN_AMP_P_24_DB), \
@@ -230,6 +248,7 @@ namespace lsp
 
             GOTT_ANALYSIS("", "", ""),
             GOTT_METERS("", ""),
+            GOTT_GR_HISTORY,
             GOTT_AMP_CURVE("", ""),
             PORTS_END
         };
@@ -260,6 +279,7 @@ namespace lsp
             GOTT_METERS("_l", " Left"),
             GOTT_ANALYSIS("_r", " Right", " R"),
             GOTT_METERS("_r", " Right"),
+            GOTT_GR_HISTORY,
             GOTT_AMP_CURVE("_l", " Left"),
             GOTT_AMP_CURVE("_r", " Right"),
             PORTS_END
@@ -296,6 +316,7 @@ namespace lsp
             GOTT_METERS("_l", " Left"),
             GOTT_ANALYSIS("_r", " Right", " R"),
             GOTT_METERS("_r", " Right"),
+            GOTT_GR_HISTORY,
             GOTT_AMP_CURVE("_l", " Left"),
             GOTT_AMP_CURVE("_r", " Right"),
             PORTS_END
@@ -332,6 +353,7 @@ namespace lsp
             GOTT_METERS("_l", " Left"),
             GOTT_ANALYSIS("_s", " Side", " S"),
             GOTT_METERS("_r", " Right"),
+            GOTT_GR_HISTORY,
             GOTT_AMP_CURVE("_m", " Mid"),
             GOTT_AMP_CURVE("_s", " Side"),
             PORTS_END
@@ -357,6 +379,7 @@ namespace lsp
 
             GOTT_ANALYSIS("", "", ""),
             GOTT_METERS("", ""),
+            GOTT_GR_HISTORY,
             GOTT_AMP_CURVE("", ""),
             PORTS_END
         };
@@ -388,6 +411,7 @@ namespace lsp
             GOTT_METERS("_l", " Left"),
             GOTT_ANALYSIS("_r", " Right", " R"),
             GOTT_METERS("_r", " Right"),
+            GOTT_GR_HISTORY,
             GOTT_AMP_CURVE("_l", " Left"),
             GOTT_AMP_CURVE("_r", " Right"),
             PORTS_END
@@ -425,6 +449,7 @@ namespace lsp
             GOTT_METERS("_l", " Left"),
             GOTT_ANALYSIS("_r", " Right", " R"),
             GOTT_METERS("_r", " Right"),
+            GOTT_GR_HISTORY,
             GOTT_AMP_CURVE("_l", " Left"),
             GOTT_AMP_CURVE("_r", " Right"),
             PORTS_END
@@ -462,6 +487,7 @@ namespace lsp
             GOTT_METERS("_l", " Left"),
             GOTT_ANALYSIS("_s", " Side", " S"),
             GOTT_METERS("_r", " Right"),
+            GOTT_GR_HISTORY,
             GOTT_AMP_CURVE("_m", " Mid"),
             GOTT_AMP_CURVE("_s", " Side"),
             PORTS_END
@@ -20,26 +20,41 @@
  */
 
 #include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/common/bits.h>
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/dsp-units/units.h>
 #include <lsp-plug.in/dsp-units/misc/envelope.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
 #include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/system.h>
 #include <lsp-plug.in/shared/debug.h>
 #include <lsp-plug.in/shared/id_colors.h>
+#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
 #include <lsp-plug.in/stdlib/string.h>
 
 #include <private/plugins/gott_compressor.h>
 
+#include <atomic>
+#include <errno.h>
+
+#ifdef PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <signal.h>
+    #include <unistd.h>
+#endif /* PLATFORM_WINDOWS */
+
 namespace lsp
 {
     namespace plugins
     {
-        /* The size of temporary buffer for audio processing */
-        static constexpr size_t GOTT_BUFFER_SIZE       = 0x200;
-
         //---------------------------------------------------------------------
         // Plugin factory
         static const meta::plugin_t *plugins[] =
@@ -61,8 +76,347 @@ namespace lsp
 
         static plug::Factory factory(plugin_factory, plugins, 8);
 
+        //---------------------------------------------------------------------
+        // Statistics segment, published only if the environment variable contains its name
+        static const char      *STATS_ENV_VAR       = "LSP_GOTT_COMPRESSOR_STATS";
+        static constexpr uint32_t STATS_MAGIC       = 0x47545453;   // 'GTTS'
+        static constexpr uint32_t STATS_INIT_MAGIC  = 0x47545449;   // 'GTTI', the header is being initialized
+        static constexpr size_t STATS_INIT_TIME     = 100;          // Time to wait for another process initializing the header [ms]
+        static constexpr uint32_t STATS_VERSION     = 2;
+        static constexpr uint32_t STATS_STALE_TIME  = 60;           // Time without updates after which the slot may be taken [s]
+
+        // Binary state snapshot, native byte order: only valid within the same build
+        static constexpr uint32_t SNAPSHOT_MAGIC    = 0x4754534e;   // 'GTSN'
+        static constexpr uint32_t SNAPSHOT_VERSION  = 1;
+
+        // Flight recorder file written by save_recorder(), native byte order
+        static constexpr uint32_t RECORDER_MAGIC    = 0x47545243;   // 'GTRC'
+        static constexpr uint32_t RECORDER_VERSION  = 1;
+
+        // States of background tasks, a cancelled task never touches the plugin data
+        static constexpr atomic_t CORE_TASK_IDLE        = 0;
+        static constexpr atomic_t CORE_TASK_BUSY        = 1;
+        static constexpr atomic_t CORE_TASK_CANCELLED   = 2;
+
+        // Number of attempts to read the format of the detector sharing bus
+        static constexpr size_t VCA_FORMAT_ATTEMPTS     = 4;
+
+        // Total refresh rate of all instances in the process [Hz], unlimited if not set
+        static const char      *REFRESH_BUDGET_ENV_VAR  = "LSP_GOTT_COMPRESSOR_REFRESH_BUDGET";
+
+        //---------------------------------------------------------------------
+        // Input and output stage kernels. Each kernel reads every input sample
+        // once and does all the work in a single pass without branches inside
+        // the loop, so the compiler is able to vectorize it.
+
+        /**
+         * Apply input gain to the mono signal and measure the peak level
+         * of the input signal
+         *
+         * @param dst destination buffer
+         * @param src input signal
+         * @param gain input gain
+         * @param count number of samples to process
+         * @return peak level of the input signal after applying the gain
+         */
+        static float input_mono(float *dst, const float *src, float gain, size_t count)
+        {
+            float peak      = 0.0f;
+            for (size_t i=0; i<count; ++i)
+            {
+                const float s   = src[i] * gain;
+                dst[i]          = s;
+                peak            = lsp_max(peak, fabsf(s));
+            }
+            return peak;
+        }
+
+        /**
+         * Apply input gain to the stereo signal and measure the peak levels
+         * of the input signal
+         *
+         * @param dl left channel destination buffer
+         * @param dr right channel destination buffer
+         * @param l left channel of the input signal
+         * @param r right channel of the input signal
+         * @param gain input gain
+         * @param peak peak levels of the input signal after applying the gain
+         * @param count number of samples to process
+         */
+        static void input_stereo(float *dl, float *dr, const float *l, const float *r, float gain, float *peak, size_t count)
+        {
+            float pl        = 0.0f;
+            float pr        = 0.0f;
+            for (size_t i=0; i<count; ++i)
+            {
+                const float sl  = l[i] * gain;
+                const float sr  = r[i] * gain;
+                dl[i]           = sl;
+                dr[i]           = sr;
+                pl              = lsp_max(pl, fabsf(sl));
+                pr              = lsp_max(pr, fabsf(sr));
+            }
+            peak[0]         = pl;
+            peak[1]         = pr;
+        }
+
+        /**
+         * Convert the stereo signal to mid/side, apply input gain and measure
+         * the peak levels of the left and right channels of the input signal
+         *
+         * @param dm middle channel destination buffer
+         * @param ds side channel destination buffer
+         * @param l left channel of the input signal
+         * @param r right channel of the input signal
+         * @param gain input gain
+         * @param peak peak levels of the left and right input channels after applying the gain
+         * @param count number of samples to process
+         */
+        static void input_ms(float *dm, float *ds, const float *l, const float *r, float gain, float *peak, size_t count)
+        {
+            // Gain is applied once at the end for the peak values
+            const float k   = gain * 0.5f;
+            float pl        = 0.0f;
+            float pr        = 0.0f;
+            for (size_t i=0; i<count; ++i)
+            {
+                const float sl  = l[i];
+                const float sr  = r[i];
+                dm[i]           = (sl + sr) * k;
+                ds[i]           = (sl - sr) * k;
+                pl              = lsp_max(pl, fabsf(sl));
+                pr              = lsp_max(pr, fabsf(sr));
+            }
+            peak[0]         = pl * gain;
+            peak[1]         = pr * gain;
+        }
+
+        /**
+         * Mix the wet and dry mono signals and measure the peak level of the result.
+         * Gains are linearly interpolated over the block.
+         *
+         * @param dst destination buffer, may be the same as the wet buffer
+         * @param wet wet signal
+         * @param dry dry signal, NULL if the dry signal is not audible
+         * @param wg0 wet gain at the beginning of the block
+         * @param wg1 wet gain at the end of the block
+         * @param dg0 dry gain at the beginning of the block
+         * @param dg1 dry gain at the end of the block
+         * @param count number of samples to process
+         * @return peak level of the output signal
+         */
+        static float output_mono(
+            float *dst, const float *wet, const float *dry,
+            float wg0, float wg1, float dg0, float dg1,
+            size_t count)
+        {
+            if (count <= 0)
+                return 0.0f;
+
+            const float wk  = (wg1 - wg0) / count;
+            float peak      = 0.0f;
+
+            if (dry == NULL)
+            {
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float s   = wet[i] * (wg0 + wk * i);
+                    dst[i]          = s;
+                    peak            = lsp_max(peak, fabsf(s));
+                }
+                return peak;
+            }
+
+            const float dk  = (dg1 - dg0) / count;
+            for (size_t i=0; i<count; ++i)
+            {
+                const float s   = wet[i] * (wg0 + wk * i) + dry[i] * (dg0 + dk * i);
+                dst[i]          = s;
+                peak            = lsp_max(peak, fabsf(s));
+            }
+            return peak;
+        }
+
+        /**
+         * Mix the wet and dry stereo signals and measure the peak levels of the result.
+         * Gains are linearly interpolated over the block.
+         *
+         * @param dl left channel destination buffer, may be the same as the wet buffer
+         * @param dr right channel destination buffer, may be the same as the wet buffer
+         * @param wl left channel of the wet signal
+         * @param wr right channel of the wet signal
+         * @param xl left channel of the dry signal, NULL if the dry signal is not audible
+         * @param xr right channel of the dry signal, NULL if the dry signal is not audible
+         * @param wg0 wet gain at the beginning of the block
+         * @param wg1 wet gain at the end of the block
+         * @param dg0 dry gain at the beginning of the block
+         * @param dg1 dry gain at the end of the block
+         * @param peak peak levels of the output signal
+         * @param count number of samples to process
+         */
+        static void output_stereo(
+            float *dl, float *dr, const float *wl, const float *wr, const float *xl, const float *xr,
+            float wg0, float wg1, float dg0, float dg1,
+            float *peak, size_t count)
+        {
+            peak[0]         = 0.0f;
+            peak[1]         = 0.0f;
+            if (count <= 0)
+                return;
+
+            const float wk  = (wg1 - wg0) / count;
+            float pl        = 0.0f;
+            float pr        = 0.0f;
+
+            if ((xl == NULL) || (xr == NULL))
+            {
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float g   = wg0 + wk * i;
+                    const float sl  = wl[i] * g;
+                    const float sr  = wr[i] * g;
+                    dl[i]           = sl;
+                    dr[i]           = sr;
+                    pl              = lsp_max(pl, fabsf(sl));
+                    pr              = lsp_max(pr, fabsf(sr));
+                }
+            }
+            else
+            {
+                const float dk  = (dg1 - dg0) / count;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float g   = wg0 + wk * i;
+                    const float d   = dg0 + dk * i;
+                    const float sl  = wl[i] * g + xl[i] * d;
+                    const float sr  = wr[i] * g + xr[i] * d;
+                    dl[i]           = sl;
+                    dr[i]           = sr;
+                    pl              = lsp_max(pl, fabsf(sl));
+                    pr              = lsp_max(pr, fabsf(sr));
+                }
+            }
+
+            peak[0]         = pl;
+            peak[1]         = pr;
+        }
+
+        /**
+         * Mix the wet and dry mid/side signals, convert the result to left/right and
+         * measure the peak levels of the result. Gains are linearly interpolated over
+         * the block.
+         *
+         * @param dl left channel destination buffer, may be the same as the middle channel of the wet signal
+         * @param dr right channel destination buffer, may be the same as the side channel of the wet signal
+         * @param wm middle channel of the wet signal
+         * @param ws side channel of the wet signal
+         * @param xm middle channel of the dry signal, NULL if the dry signal is not audible
+         * @param xs side channel of the dry signal, NULL if the dry signal is not audible
+         * @param wg0 wet gain at the beginning of the block
+         * @param wg1 wet gain at the end of the block
+         * @param dg0 dry gain at the beginning of the block
+         * @param dg1 dry gain at the end of the block
+         * @param peak peak levels of the output signal
+         * @param count number of samples to process
+         */
+        static void output_ms(
+            float *dl, float *dr, const float *wm, const float *ws, const float *xm, const float *xs,
+            float wg0, float wg1, float dg0, float dg1,
+            float *peak, size_t count)
+        {
+            peak[0]         = 0.0f;
+            peak[1]         = 0.0f;
+            if (count <= 0)
+                return;
+
+            // The conversion is linear, so mixing is done before conversion
+            const float wk  = (wg1 - wg0) / count;
+            float pl        = 0.0f;
+            float pr        = 0.0f;
+
+            if ((xm == NULL) || (xs == NULL))
+            {
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float g   = wg0 + wk * i;
+                    const float m   = wm[i] * g;
+                    const float s   = ws[i] * g;
+                    dl[i]           = m + s;
+                    dr[i]           = m - s;
+                    pl              = lsp_max(pl, fabsf(m + s));
+                    pr              = lsp_max(pr, fabsf(m - s));
+                }
+            }
+            else
+            {
+                const float dk  = (dg1 - dg0) / count;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float g   = wg0 + wk * i;
+                    const float d   = dg0 + dk * i;
+                    const float m   = wm[i] * g + xm[i] * d;
+                    const float s   = ws[i] * g + xs[i] * d;
+                    dl[i]           = m + s;
+                    dr[i]           = m - s;
+                    pl              = lsp_max(pl, fabsf(m + s));
+                    pr              = lsp_max(pr, fabsf(m - s));
+                }
+            }
+
+            peak[0]         = pl;
+            peak[1]         = pr;
+        }
+
+        /**
+         * Compute one row of the pre-mix matrix
+         *
+         * @param dst destination buffer for the mixed signal
+         * @param src list of source buffers, indexed by the bus number
+         * @param k row of the mixing matrix
+         * @param mask mask of non-zero and available sources
+         * @param self index of the bus that corresponds to the row
+         * @param count number of samples to process
+         * @return pointer to the resulting signal: either the source buffer or the destination buffer
+         */
+        static float *premix_row(float *dst, float * const *src, const float *k, uint32_t mask, size_t self, size_t count)
+        {
+            // Pass the own source if there is nothing to mix into it
+            if (!(mask & ~(uint32_t(1) << self)))
+                return src[self];
+
+            const float *s[3];
+            float g[3];
+            size_t n        = 0;
+            for (size_t i=0; i<3; ++i)
+            {
+                if (!(mask & (uint32_t(1) << i)))
+                    continue;
+                s[n]            = src[i];
+                g[n]            = k[i];
+                ++n;
+            }
+
+            if (n >= 3)
+                dsp::mix_copy3(dst, s[0], s[1], s[2], g[0], g[1], g[2], count);
+            else if (n == 2)
+                dsp::mix_copy2(dst, s[0], s[1], g[0], g[1], count);
+            else
+                dsp::mul_k3(dst, s[0], g[0], count);
+
+            return dst;
+        }
+
         //---------------------------------------------------------------------
         // Implementation
+        ipc::Mutex gott_compressor::sSharedLock;
+        gott_compressor::freq_grid_t *gott_compressor::pFreqGrids = NULL;
+        gott_compressor::vca_bus_t *gott_compressor::vVcaBuses[meta::gott_compressor::VCA_GROUP_MAX] = { NULL };
+        ipc::SharedMem *gott_compressor::pStatsShm = NULL;
+        size_t gott_compressor::nStatsRefs = 0;
+        atomic_t gott_compressor::nInstances = 0;
+        thread_local uint32_t gott_compressor::nRtDepth = 0;
+        atomic_t gott_compressor::nRtViolations = 0;
+
         gott_compressor::gott_compressor(const meta::plugin_t *meta):
             Module(meta)
         {
@@ -116,6 +470,13 @@ namespace lsp
             sPremix.fScToIn     = GAIN_AMP_M_INF_DB;
             sPremix.fScToLink   = GAIN_AMP_M_INF_DB;
 
+            for (size_t i=0; i<PM_TOTAL; ++i)
+            {
+                for (size_t j=0; j<PM_TOTAL; ++j)
+                    sPremix.vMatrix[i][j]   = (i == j) ? 1.0f : 0.0f;
+                sPremix.vMask[i]    = uint32_t(1) << i;
+            }
+
             for (size_t i=0; i<2; ++i)
             {
                 sPremix.vIn[i]      = NULL;
@@ -137,15 +498,34 @@ namespace lsp
             enXOver             = XOVER_MODERN;
             nBands              = meta::gott_compressor::BANDS_MAX;
             nScType             = SCT_INTERNAL;
+            pProcessBlock       = select_process_block(enXOver, nScType);
+            nBlockSize          = meta::gott_compressor::BLOCK_SIZE_MIN;
+            nHostBlock          = 0;
+            nHostPeak           = 0;
+            nHostTime           = 0;
+            nScMode             = 0;
+            nScSource           = 0;
+            fScReact            = -1.0f;
+            fMaxAttack          = -1.0f;
             bProt               = true;
             bEnvUpdate          = true;
             bStereoSplit        = false;
+            nBypassState        = BYP_ACTIVE;
+            nBypassCounter      = 0;
             fInGain             = GAIN_AMP_0_DB;
             fDryGain            = GAIN_AMP_M_INF_DB;
             fWetGain            = GAIN_AMP_0_DB;
+            fOldDryGain         = fDryGain;
+            fOldWetGain         = fWetGain;
             fScPreamp           = GAIN_AMP_0_DB;
+            nDryHold            = 0;
+            nWetHold            = 0;
+            bDryOn              = true;
+            bWetOn              = true;
             nEnvBoost           = 0;
             fZoom               = GAIN_AMP_0_DB;
+            fGrTime             = meta::gott_compressor::GR_HISTORY_TIME_DFL;
+            fRefreshRate        = meta::gott_compressor::REFRESH_RATE;
             for (size_t i=0; i<meta::gott_compressor::BANDS_MAX-1; ++i)
                 vSplits[i]          = 0.0f;
 
@@ -164,10 +544,22 @@ namespace lsp
             vTr                 = NULL;
             vPFc                = NULL;
             vRFc                = NULL;
+            vTmpFilter          = NULL;
             vCurveBuffer        = NULL;
             vFreqBuffer         = NULL;
             vFreqIndexes        = NULL;
+            pFreqGrid           = NULL;
             pIDisplay           = NULL;
+            sIDisplay.vFreqs    = NULL;
+            sIDisplay.nWidth    = 0;
+            sIDisplay.nHeight   = 0;
+            sIDisplay.fZoom     = 0.0f;
+            sIDisplay.nGridX    = 0;
+            sIDisplay.nGridY    = 0;
+            sIDisplay.fZy       = 0.0f;
+            sIDisplay.fDy       = 0.0f;
+            bIDisplaySync       = true;
+            bIDisplayBypass     = false;
 
             pBypass             = NULL;
             pMode               = NULL;
@@ -186,6 +578,7 @@ namespace lsp
             pReactivity         = NULL;
             pShiftGain          = NULL;
             pZoom               = NULL;
+            pGrTime             = NULL;
             pEnvBoost           = NULL;
             pSplits[0]          = NULL;
             pSplits[1]          = NULL;
@@ -194,7 +587,38 @@ namespace lsp
             pScType             = NULL;
             pStereoSplit        = NULL;
 
+            init_xover_state(&sXOver);
+            init_xover_state(&sXOverNew);
+            init_xover_state(&sXOverGarbage);
+            pXOverLoader        = NULL;
+            init_block_state(&sBlock);
+            init_block_state(&sBlockNew);
+            init_block_state(&sBlockGarbage);
+            pBlockLoader        = NULL;
+            pAnLoader           = NULL;
+            nVcaShare           = VCA_SHARE_OFF;
+            pVcaBus             = NULL;
+            pVcaBusNew          = NULL;
+            pVcaBusGarbage      = NULL;
+            pVcaLoader          = NULL;
+            nVcaGroup           = 0;
+            nVcaGroupNew        = 0;
+            nVcaTail            = 0;
+            nVcaHold            = 0;
+            fVcaMix             = 0.0f;
+            bVcaLeader          = false;
+            bVcaSync            = false;
+            pVcaShare           = NULL;
+            pVcaGroup           = NULL;
+            pStats              = NULL;
+            nStatsOwner         = 0;
+            vRecFrames          = NULL;
+            nRecHead            = 0;
+            bAnalyzer           = false;
+            bAnRequest          = false;
+
             pData               = NULL;
+            nDataSize           = 0;
         }
 
         gott_compressor::~gott_compressor()
@@ -207,21 +631,12 @@ namespace lsp
             // Call parent class for initialization
             plug::Module::init(wrapper, ports);
 
-            // Initialize analyzer
+            // The analyzer is initialized by the loader on first UI activation
             size_t channels         = (nMode == GOTT_MONO) ? 1 : 2;
             size_t an_cid           = 0;
             size_t filter_cid       = 0;
-            if (!sAnalyzer.init(2*channels, meta::gott_compressor::FFT_RANK,
-                                MAX_SAMPLE_RATE, meta::gott_compressor::REFRESH_RATE))
-                return;
-
-            sAnalyzer.set_rank(meta::gott_compressor::FFT_RANK);
-            sAnalyzer.set_activity(false);
-            sAnalyzer.set_envelope(dspu::envelope::WHITE_NOISE);
-            sAnalyzer.set_window(meta::gott_compressor::FFT_WINDOW);
-            sAnalyzer.set_rate(meta::gott_compressor::REFRESH_RATE);
 
-            sCounter.set_frequency(meta::gott_compressor::REFRESH_RATE, true);
+            sCounter.set_frequency(fRefreshRate, true);
 
             // Initialize filters according to number of bands
             if (sFilters.init(meta::gott_compressor::BANDS_MAX * channels) != STATUS_OK)
@@ -231,39 +646,33 @@ namespace lsp
             if (!sProtSC.init(channels, meta::gott_compressor::SC_REACTIVITY_MAX))
                 return;
 
+            // Buffers of the processing block are allocated separately, their size follows the host buffer size
+            nBlockSize              = meta::gott_compressor::BLOCK_SIZE_MIN;
+            nHostBlock              = 0;
+            nHostPeak               = 0;
+            nHostTime               = 0;
+
             // Compute amount of memory
             size_t szof_channels    = align_size(sizeof(channel_t) * channels, OPTIMAL_ALIGN);
-            size_t szof_buffer      = align_size(sizeof(float) * GOTT_BUFFER_SIZE, OPTIMAL_ALIGN);
-            size_t szof_curve       = align_size(sizeof(float) * meta::gott_compressor::CURVE_MESH_SIZE, OPTIMAL_ALIGN);
             size_t szof_freq        = align_size(sizeof(float) * meta::gott_compressor::FFT_MESH_POINTS, OPTIMAL_ALIGN);
-            size_t szof_indexes     = align_size(meta::gott_compressor::FFT_MESH_POINTS * sizeof(uint32_t), OPTIMAL_ALIGN);
-
-            size_t to_alloc         =
-                szof_channels +
-                szof_buffer +       // vBuffer
-                szof_buffer +       // vProtBuffer
-                szof_buffer*2 +     // vSC[2]
-                szof_buffer +       // vEnv
+            size_t szof_mesh        =
                 szof_freq*2 +       // vTr
                 szof_freq*2 +       // vPFc
                 szof_freq*2 +       // vRFc
-                szof_curve +        // vCurveBuffer
-                szof_freq +         // vFreqBuffer
-                szof_indexes +      // vFreqIndexes
+                szof_freq*2;        // vTmpFilter
+            size_t szof_record      = align_size(sizeof(rec_frame_t) * meta::gott_compressor::RECORDER_FRAMES, OPTIMAL_ALIGN);
+            size_t szof_history     = align_size(sizeof(float) * meta::gott_compressor::GR_HISTORY_POINTS, OPTIMAL_ALIGN);
+
+            size_t to_alloc         =
+                szof_channels +
+                szof_mesh +         // Buffers for computing meshes
+                szof_record +       // vRecFrames
                 (
-                    szof_buffer * 3 + // sPremix
-                    szof_buffer +   // vInBuffer for each channel
-                    szof_buffer +   // vBuffer for each channel
-                    szof_buffer +   // vScBuffer for each channel
-                    szof_buffer +   // vInAnalyze each channel
-                    szof_freq*2 +   // vTmpFilterBuffer
                     szof_freq +     // vFilterBuffer
                     (
-                        szof_buffer +   // vBuffer
-                        szof_buffer +   // vVCA
-                        szof_curve +    // vCurveBuffer
-                        szof_freq*2 +   // vFilterBuffer
-                        szof_freq*2     // vSidechainBuffer
+                        szof_freq +     // vFilterBuffer
+                        szof_freq +     // vSidechainBuffer
+                        szof_history * 2 * meta::gott_compressor::GR_HISTORY_LEVELS // vHistory
                     ) * meta::gott_compressor::BANDS_MAX
                 ) * channels;
 
@@ -271,28 +680,17 @@ namespace lsp
             uint8_t *ptr            = alloc_aligned<uint8_t>(pData, to_alloc);
             if (ptr == NULL)
                 return;
+            nDataSize               = to_alloc;
 
             vChannels               = advance_ptr_bytes<channel_t>(ptr, szof_channels);
 
-            vBuffer                 = advance_ptr_bytes<float>(ptr, szof_buffer);
-            vProtBuffer             = advance_ptr_bytes<float>(ptr, szof_buffer);
-            vSC[0]                  = advance_ptr_bytes<float>(ptr, szof_buffer);
-            vSC[1]                  = advance_ptr_bytes<float>(ptr, szof_buffer);
-            vEnv                    = advance_ptr_bytes<float>(ptr, szof_buffer);
             vTr                     = advance_ptr_bytes<float>(ptr, szof_freq*2);
             vPFc                    = advance_ptr_bytes<float>(ptr, szof_freq*2);
             vRFc                    = advance_ptr_bytes<float>(ptr, szof_freq*2);
-            vCurveBuffer            = advance_ptr_bytes<float>(ptr, szof_curve);
-            vFreqBuffer             = advance_ptr_bytes<float>(ptr, szof_freq);
-            vFreqIndexes            = advance_ptr_bytes<uint32_t>(ptr, szof_indexes);
+            vTmpFilter              = advance_ptr_bytes<float>(ptr, szof_freq*2);
 
-            // Initialize pre-mix
-            for (size_t i=0; i<channels; ++i)
-            {
-                sPremix.vTmpIn[i]       = advance_ptr_bytes<float>(ptr, szof_buffer);
-                sPremix.vTmpLink[i]     = advance_ptr_bytes<float>(ptr, szof_buffer);
-                sPremix.vTmpSc[i]       = advance_ptr_bytes<float>(ptr, szof_buffer);
-            }
+            vRecFrames              = advance_ptr_bytes<rec_frame_t>(ptr, szof_record);
+            memset(vRecFrames, 0, szof_record);
 
             // Initialize channels
             for (size_t i=0; i<channels; ++i)
@@ -310,17 +708,21 @@ namespace lsp
                 c->sDryEq.construct();
                 c->sDryEq.init(meta::gott_compressor::BANDS_MAX - 1, 0);
                 c->sDryEq.set_mode(dspu::EQM_IIR);
-                c->sFFTXOver.construct();
-                c->sDryDelay.construct();
-                c->sAnDelay.construct();
-                c->sScDelay.construct();
-                c->sXOverDelay.construct();
+                c->pFFTXOver            = NULL;
 
-                c->sDelay.construct();
+                for (size_t j=0; j<DL_TOTAL; ++j)
+                {
+                    c->sDelay.vLane[j]      = NULL;
+                    c->sDelay.vSize[j]      = 0;
+                    c->sDelay.vHead[j]      = 0;
+                }
+                c->sDelay.nLookahead    = 0;
+                c->sDelay.nXOver        = 0;
 
                 // Initialize bands
                 for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                 {
+                    band_vca_t *v       = &c->vVca[j];
                     band_t *b           = &c->vBands[j];
 
                     b->sSC.construct();
@@ -340,13 +742,16 @@ namespace lsp
                     if (!b->sAllFilter.init(NULL))
                         return;
 
-                    // Initialize sidechain equalizers
-                    b->sEQ[0].init(2, 0);
-                    b->sEQ[0].set_mode(dspu::EQM_IIR);
-                    if (channels > 1)
+                    // Initialize sidechain equalizers, equalizers of the first channel serve all channels
+                    if (i == 0)
                     {
-                        b->sEQ[1].init(2, 0);
-                        b->sEQ[1].set_mode(dspu::EQM_IIR);
+                        b->sEQ[0].init(2, 0);
+                        b->sEQ[0].set_mode(dspu::EQM_IIR);
+                        if (channels > 1)
+                        {
+                            b->sEQ[1].init(2, 0);
+                            b->sEQ[1].set_mode(dspu::EQM_IIR);
+                        }
                     }
 
                     // Initialize dynamic processor
@@ -357,60 +762,86 @@ namespace lsp
                     }
 
                     // Initialize oteher fields
-                    b->vBuffer          = advance_ptr_bytes<float>(ptr, szof_buffer);
-                    b->vVCA             = advance_ptr_bytes<float>(ptr, szof_buffer);
-                    b->vCurveBuffer     = advance_ptr_bytes<float>(ptr, szof_curve);
-                    b->vFilterBuffer    = advance_ptr_bytes<float>(ptr, szof_freq * 2);
-                    b->vSidechainBuffer = advance_ptr_bytes<float>(ptr, szof_freq * 2);
-
-                    b->fMinThresh       = GAIN_AMP_M_72_DB;
-                    b->fUpThresh        = GAIN_AMP_M_48_DB;
-                    b->fDownThresh      = GAIN_AMP_M_12_DB;
-                    b->fUpRatio         = 100.0f;
-                    b->fDownRatio       = 4.0f;
-                    b->fAttackTime      = 10.0f;
-                    b->fReleaseTime     = 10.0f;
-                    b->fMakeup          = GAIN_AMP_0_DB;
-                    b->fGainLevel       = 0.0f;
+                    v->vBuffer          = NULL;
+                    v->vVCA             = NULL;
+                    v->vLeader          = NULL;
+                    v->fVcaHold         = GAIN_AMP_0_DB;
+                    v->fMakeup          = GAIN_AMP_0_DB;
+                    v->fGainLevel       = 0.0f;
+                    v->nFilterID        = filter_cid++;
+                    v->bEnabled         = true;
+                    v->bMute            = false;
+
+                    b->vFilterBuffer    = advance_ptr_bytes<float>(ptr, szof_freq);
+                    b->vSidechainBuffer = advance_ptr_bytes<float>(ptr, szof_freq);
+                    b->fRefreshGain     = GAIN_AMP_0_DB;
+
+                    // Initialize gain reduction history with unit gain
+                    for (size_t k=0; k<meta::gott_compressor::GR_HISTORY_LEVELS; ++k)
+                    {
+                        grh_level_t *lv     = &b->vHistory[k];
+                        lv->vMin            = advance_ptr_bytes<float>(ptr, szof_history);
+                        lv->vMax            = advance_ptr_bytes<float>(ptr, szof_history);
+                        lv->fMin            = GAIN_AMP_0_DB;
+                        lv->fMax            = GAIN_AMP_0_DB;
+                        lv->nCount          = 0;
+                        lv->nHead           = 0;
+                        dsp::fill_one(lv->vMin, meta::gott_compressor::GR_HISTORY_POINTS);
+                        dsp::fill_one(lv->vMax, meta::gott_compressor::GR_HISTORY_POINTS);
+                    }
+
+                    // Negative values force the first update_settings() call to apply all parameters
+                    b->fMinThresh       = -1.0f;
+                    b->fUpThresh        = -1.0f;
+                    b->fDownThresh      = -1.0f;
+                    b->fUpRatio         = -1.0f;
+                    b->fDownRatio       = -1.0f;
+                    b->fKnee            = -1.0f;
+                    b->fAttackTime      = -1.0f;
+                    b->fReleaseTime     = -1.0f;
                     b->nSync            = S_ALL;
 
-                    b->nFilterID        = filter_cid++;
-                    b->bEnabled         = true;
                     b->bSolo            = false;
-                    b->bMute            = false;
-
-                    b->pMinThresh       = NULL;
-                    b->pUpThresh        = NULL;
-                    b->pDownThresh      = NULL;
-                    b->pUpRatio         = NULL;
-                    b->pDownRatio       = NULL;
-                    b->pKnee            = NULL;
-                    b->pAttackTime      = NULL;
-                    b->pReleaseTime     = NULL;
-                    b->pMakeup          = NULL;
-
-                    b->pEnabled         = NULL;
-                    b->pSolo            = NULL;
-                    b->pMute            = NULL;
-                    b->pCurveMesh       = NULL;
-                    b->pFreqMesh        = NULL;
-                    b->pEnvLvl          = NULL;
-                    b->pCurveLvl        = NULL;
-                    b->pMeterGain       = NULL;
+                    b->bMuteSw          = false;
+                    b->bDirty           = true;
+
+                    band_ports_t *bp    = &c->vBandPorts[j];
+                    b->pPorts           = bp;
+                    bp->pMinThresh      = NULL;
+                    bp->pUpThresh       = NULL;
+                    bp->pDownThresh     = NULL;
+                    bp->pUpRatio        = NULL;
+                    bp->pDownRatio      = NULL;
+                    bp->pKnee           = NULL;
+                    bp->pAttackTime     = NULL;
+                    bp->pReleaseTime    = NULL;
+                    bp->pMakeup         = NULL;
+
+                    bp->pEnabled        = NULL;
+                    bp->pSolo           = NULL;
+                    bp->pMute           = NULL;
+                    bp->pCurveMesh      = NULL;
+                    bp->pFreqMesh       = NULL;
+                    bp->pEnvLvl         = NULL;
+                    bp->pCurveLvl       = NULL;
+                    bp->pMeterGain      = NULL;
                 }
 
                 c->vIn                  = NULL;
                 c->vOut                 = NULL;
                 c->vScIn                = NULL;
                 c->vShmIn               = NULL;
-                c->vInBuffer            = advance_ptr_bytes<float>(ptr, szof_buffer);
-                c->vBuffer              = advance_ptr_bytes<float>(ptr, szof_buffer);
-                c->vScBuffer            = advance_ptr_bytes<float>(ptr, szof_buffer);
-                c->vInAnalyze           = advance_ptr_bytes<float>(ptr, szof_buffer);
-                c->vTmpFilterBuffer     = advance_ptr_bytes<float>(ptr, szof_freq * 2);
+                c->vInBuffer            = NULL;
+                c->vBuffer              = NULL;
+                c->vScBuffer            = NULL;
+                c->vInAnalyze           = NULL;
                 c->vFilterBuffer        = advance_ptr_bytes<float>(ptr, szof_freq);
-
-                vSCIn[i]                = c->vScBuffer;
+                dsp::fill_one(c->vFilterBuffer, meta::gott_compressor::FFT_MESH_POINTS);
+                c->bAmpSync             = false;
+                c->fRefreshIn           = 0.0f;
+                c->fRefreshOut          = 0.0f;
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                    c->vAmpGain[j]          = -1.0f;
 
                 c->nAnInChannel         = an_cid++;
                 c->nAnOutChannel        = an_cid++;
@@ -430,6 +861,7 @@ namespace lsp
                 c->pFftIn               = NULL;
                 c->pFftOut              = NULL;
                 c->pAmpGraph            = NULL;
+                c->pGrHistory           = NULL;
                 c->pInLvl               = NULL;
                 c->pOutLvl              = NULL;
             }
@@ -493,6 +925,8 @@ namespace lsp
             SKIP_PORT("Filter curve enable switch"); // Skip filter curve enable button
             BIND_PORT(pExtraBand);
             BIND_PORT(pScMode);
+            BIND_PORT(pVcaShare);
+            BIND_PORT(pVcaGroup);
             if (nMode == GOTT_STEREO)
             {
                 BIND_PORT(pStereoSplit);
@@ -513,49 +947,49 @@ namespace lsp
                 {
                     for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                     {
-                        band_t *b               = &c->vBands[j];
-                        band_t *sb              = &vChannels[0].vBands[j];
-
-                        b->pMinThresh           = sb->pMinThresh;
-                        b->pUpThresh            = sb->pUpThresh;
-                        b->pDownThresh          = sb->pDownThresh;
-                        b->pUpRatio             = sb->pUpRatio;
-                        b->pDownRatio           = sb->pDownRatio;
-                        b->pKnee                = sb->pKnee;
-                        b->pAttackTime          = sb->pAttackTime;
-                        b->pReleaseTime         = sb->pReleaseTime;
-                        b->pMakeup              = sb->pMakeup;
-
-                        b->pEnabled             = sb->pEnabled;
-                        b->pSolo                = sb->pSolo;
-                        b->pMute                = sb->pMute;
-
-                        b->pCurveMesh           = sb->pCurveMesh;
-                        b->pFreqMesh            = sb->pFreqMesh;
+                        band_ports_t *bp        = &c->vBandPorts[j];
+                        band_ports_t *sbp       = &vChannels[0].vBandPorts[j];
+
+                        bp->pMinThresh          = sbp->pMinThresh;
+                        bp->pUpThresh           = sbp->pUpThresh;
+                        bp->pDownThresh         = sbp->pDownThresh;
+                        bp->pUpRatio            = sbp->pUpRatio;
+                        bp->pDownRatio          = sbp->pDownRatio;
+                        bp->pKnee               = sbp->pKnee;
+                        bp->pAttackTime         = sbp->pAttackTime;
+                        bp->pReleaseTime        = sbp->pReleaseTime;
+                        bp->pMakeup             = sbp->pMakeup;
+
+                        bp->pEnabled            = sbp->pEnabled;
+                        bp->pSolo               = sbp->pSolo;
+                        bp->pMute               = sbp->pMute;
+
+                        bp->pCurveMesh          = sbp->pCurveMesh;
+                        bp->pFreqMesh           = sbp->pFreqMesh;
                     }
                 }
                 else
                 {
                     for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                     {
-                        band_t *b               = &c->vBands[j];
-
-                        BIND_PORT(b->pMinThresh);
-                        BIND_PORT(b->pUpThresh);
-                        BIND_PORT(b->pDownThresh);
-                        BIND_PORT(b->pUpRatio);
-                        BIND_PORT(b->pDownRatio);
-                        BIND_PORT(b->pKnee);
-                        BIND_PORT(b->pAttackTime);
-                        BIND_PORT(b->pReleaseTime);
-                        BIND_PORT(b->pMakeup);
-
-                        BIND_PORT(b->pEnabled);
-                        BIND_PORT(b->pSolo);
-                        BIND_PORT(b->pMute);
-
-                        BIND_PORT(b->pCurveMesh);
-                        BIND_PORT(b->pFreqMesh);
+                        band_ports_t *bp        = &c->vBandPorts[j];
+
+                        BIND_PORT(bp->pMinThresh);
+                        BIND_PORT(bp->pUpThresh);
+                        BIND_PORT(bp->pDownThresh);
+                        BIND_PORT(bp->pUpRatio);
+                        BIND_PORT(bp->pDownRatio);
+                        BIND_PORT(bp->pKnee);
+                        BIND_PORT(bp->pAttackTime);
+                        BIND_PORT(bp->pReleaseTime);
+                        BIND_PORT(bp->pMakeup);
+
+                        BIND_PORT(bp->pEnabled);
+                        BIND_PORT(bp->pSolo);
+                        BIND_PORT(bp->pMute);
+
+                        BIND_PORT(bp->pCurveMesh);
+                        BIND_PORT(bp->pFreqMesh);
                     }
                 }
             }
@@ -566,11 +1000,11 @@ namespace lsp
                 channel_t *c            = &vChannels[i];
                 for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                 {
-                    band_t *b               = &c->vBands[j];
+                    band_ports_t *bp        = &c->vBandPorts[j];
 
-                    BIND_PORT(b->pEnvLvl);
-                    BIND_PORT(b->pCurveLvl);
-                    BIND_PORT(b->pMeterGain);
+                    BIND_PORT(bp->pEnvLvl);
+                    BIND_PORT(bp->pCurveLvl);
+                    BIND_PORT(bp->pMeterGain);
                 }
             }
 
@@ -587,16 +1021,46 @@ namespace lsp
             }
 
             lsp_trace("Binding aplification curve ports");
+            BIND_PORT(pGrTime);
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c            = &vChannels[i];
                 BIND_PORT(c->pAmpGraph);
+                BIND_PORT(c->pGrHistory);
             }
 
-            // Initialize curve (logarithmic) in range of -72 .. +24 db
-            float delta = (meta::gott_compressor::CURVE_DB_MAX - meta::gott_compressor::CURVE_DB_MIN) / (meta::gott_compressor::CURVE_MESH_SIZE-1);
-            for (size_t i=0; i<meta::gott_compressor::CURVE_MESH_SIZE; ++i)
-                vCurveBuffer[i]         = dspu::db_to_gain(meta::gott_compressor::CURVE_DB_MIN + delta * i);
+            // Use the shared curve (logarithmic) in range of -72 .. +24 db
+            vCurveBuffer            = curve_grid();
+
+            // Allocate buffers of the processing block for the minimum block size, the loader
+            // reallocates them when the host buffer size is known
+            if (!alloc_block_state(&sBlockNew, meta::gott_compressor::BLOCK_SIZE_MIN))
+                return;
+            apply_block_state(&sBlockNew);
+            free_block_state(&sBlockNew);
+
+            // Create loaders of linear phase state, block buffers, analyzer and detector sharing bus
+            pXOverLoader            = new XOverLoader(this);
+            pBlockLoader            = new BlockLoader(this);
+            pAnLoader               = new AnalyzerLoader(this);
+            pVcaLoader              = new VcaLoader(this);
+
+            // Join the refresh budget of the process
+            refresh_budget();
+            atomic_add(&nInstances, 1);
+
+            // Take the slot in the statistics segment if enabled
+            pStats                  = acquire_stats_slot(&nStatsOwner);
+            if (pStats != NULL)
+            {
+                const uint32_t serial   = pStats->nSerial;
+                atomic_store(&pStats->nSerial, uint32_t(serial + 1));
+                std::atomic_thread_fence(std::memory_order_release);
+                pStats->nMode           = nMode;
+                pStats->nChannels       = channels;
+                std::atomic_thread_fence(std::memory_order_release);
+                atomic_store(&pStats->nSerial, uint32_t(serial + 2));
+            }
         }
 
         void gott_compressor::destroy()
@@ -605,8 +1069,62 @@ namespace lsp
             do_destroy();
         }
 
+        bool gott_compressor::wait_task(CoreTask *task)
+        {
+            if (task == NULL)
+                return true;
+            rt_check();
+
+            // A queued task is waited for a limited time and then cancelled, the executor
+            // still references it, so the cancelled task is never deleted
+            for (size_t i=0; (task->submitted()) && (i < meta::gott_compressor::TASK_WAIT_TIME); ++i)
+                system::sleep_msec(1);
+            if ((task->submitted()) && (task->cancel()))
+            {
+                lsp_warn("Background task %p is still queued, cancelled", task);
+                return false;
+            }
+
+            // A running task works on the plugin data, it is short and always completes.
+            // The executor accesses the task until it is marked as completed
+            while ((task->busy()) || (task->submitted()) || (task->running()))
+                system::sleep_msec(1);
+            return true;
+        }
+
         void gott_compressor::do_destroy()
         {
+            // Leave the refresh budget, the instance has joined it if initialization has completed
+            if (pXOverLoader != NULL)
+                atomic_add(&nInstances, -1);
+
+            // Loaders operate on the plugin data, they should finish or be cancelled before
+            // anything is freed. Cancelled tasks are left to the executor
+            if (!wait_task(pXOverLoader))
+                pXOverLoader            = NULL;
+            if (!wait_task(pBlockLoader))
+                pBlockLoader            = NULL;
+            if (!wait_task(pAnLoader))
+                pAnLoader               = NULL;
+            if (!wait_task(pVcaLoader))
+                pVcaLoader              = NULL;
+
+            // Leave the detector sharing group
+            leave_vca_bus();
+            release_vca_bus(pVcaBus);
+            release_vca_bus(pVcaBusNew);
+            release_vca_bus(pVcaBusGarbage);
+            pVcaBus                 = NULL;
+            pVcaBusNew              = NULL;
+            pVcaBusGarbage          = NULL;
+
+            // Free the slot in the statistics segment
+            if (pStats != NULL)
+            {
+                release_stats_slot(pStats, nStatsOwner);
+                pStats                  = NULL;
+            }
+
             // Destroy analyzer
             sAnalyzer.destroy();
 
@@ -630,12 +1148,7 @@ namespace lsp
                     c->sEnvBoost[0].destroy();
                     c->sEnvBoost[1].destroy();
                     c->sDryEq.destroy();
-                    c->sFFTXOver.destroy();
-                    c->sDelay.destroy();
-                    c->sDryDelay.destroy();
-                    c->sAnDelay.destroy();
-                    c->sScDelay.destroy();
-                    c->sXOverDelay.destroy();
+                    c->pFFTXOver            = NULL;
 
                     for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                     {
@@ -661,18 +1174,64 @@ namespace lsp
                 pIDisplay   = NULL;
             }
 
+            // Release shared frequency grid
+            if (pFreqGrid != NULL)
+            {
+                release_freq_grid(pFreqGrid);
+                pFreqGrid               = NULL;
+                vFreqBuffer             = NULL;
+                vFreqIndexes            = NULL;
+            }
+
             // Free allocated data
             if (pData != NULL)
             {
                 free_aligned(pData);
                 pData                   = NULL;
             }
+
+            // Destroy linear phase state
+            if (pXOverLoader != NULL)
+            {
+                delete pXOverLoader;
+                pXOverLoader            = NULL;
+            }
+            free_xover_state(&sXOver);
+            free_xover_state(&sXOverNew);
+            free_xover_state(&sXOverGarbage);
+
+            // Destroy buffers of the processing block
+            if (pBlockLoader != NULL)
+            {
+                delete pBlockLoader;
+                pBlockLoader            = NULL;
+            }
+            free_block_state(&sBlock);
+            free_block_state(&sBlockNew);
+            free_block_state(&sBlockGarbage);
+
+            // Destroy analyzer loader
+            if (pAnLoader != NULL)
+            {
+                delete pAnLoader;
+                pAnLoader               = NULL;
+            }
+
+            // Destroy detector sharing bus loader
+            if (pVcaLoader != NULL)
+            {
+                delete pVcaLoader;
+                pVcaLoader              = NULL;
+            }
         }
 
         void gott_compressor::ui_activated()
         {
             size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
 
+            // Request the analyzer, it will be initialized by the loader
+            bAnRequest          = true;
+
             // Force meshes with the UI to synchronized
             for (size_t i=0; i<channels; ++i)
             {
@@ -686,6 +1245,266 @@ namespace lsp
             }
         }
 
+        const float *gott_compressor::curve_grid()
+        {
+            // The curve does not depend on any setting and is computed once for all instances
+            struct curve_grid_t
+            {
+                float   v[meta::gott_compressor::CURVE_MESH_SIZE];
+
+                curve_grid_t()
+                {
+                    const float delta   = (meta::gott_compressor::CURVE_DB_MAX - meta::gott_compressor::CURVE_DB_MIN) / (meta::gott_compressor::CURVE_MESH_SIZE-1);
+                    for (size_t i=0; i<meta::gott_compressor::CURVE_MESH_SIZE; ++i)
+                        v[i]                = dspu::db_to_gain(meta::gott_compressor::CURVE_DB_MIN + delta * i);
+                }
+            };
+
+            static const curve_grid_t grid;
+            return grid.v;
+        }
+
+        gott_compressor::freq_grid_t *gott_compressor::acquire_freq_grid(size_t sr)
+        {
+            rt_check();
+
+            if (!sSharedLock.lock())
+                return NULL;
+            lsp_finally { sSharedLock.unlock(); };
+
+            // Look up the grid for the same sample rate
+            for (freq_grid_t *grid = pFreqGrids; grid != NULL; grid = grid->pNext)
+            {
+                if (grid->nSampleRate == sr)
+                {
+                    ++grid->nRefs;
+                    return grid;
+                }
+            }
+
+            // Create new grid, the frequencies depend only on the sample rate and the analyzer's rank
+            dspu::Analyzer an;
+            lsp_finally { an.destroy(); };
+            if (!an.init(1, meta::gott_compressor::FFT_RANK, sr, meta::gott_compressor::REFRESH_RATE))
+                return NULL;
+            an.set_rank(meta::gott_compressor::FFT_RANK);
+            an.set_rate(meta::gott_compressor::REFRESH_RATE);
+            an.set_sample_rate(sr);
+            an.reconfigure();
+
+            freq_grid_t *grid   = static_cast<freq_grid_t *>(malloc(sizeof(freq_grid_t)));
+            if (grid == NULL)
+                return NULL;
+
+            an.get_frequencies(
+                grid->vFreqs,
+                grid->vIndexes,
+                SPEC_FREQ_MIN,
+                SPEC_FREQ_MAX,
+                meta::gott_compressor::FFT_MESH_POINTS);
+            grid->nSampleRate   = sr;
+            grid->nRefs         = 1;
+            grid->pNext         = pFreqGrids;
+            pFreqGrids          = grid;
+
+            return grid;
+        }
+
+        void gott_compressor::release_freq_grid(freq_grid_t *grid)
+        {
+            rt_check();
+
+            if (!sSharedLock.lock())
+                return;
+            lsp_finally { sSharedLock.unlock(); };
+
+            if ((--grid->nRefs) > 0)
+                return;
+
+            // Remove the grid from the list
+            for (freq_grid_t **pp = &pFreqGrids; *pp != NULL; pp = &(*pp)->pNext)
+            {
+                if (*pp == grid)
+                {
+                    *pp             = grid->pNext;
+                    break;
+                }
+            }
+            free(grid);
+        }
+
+        static uint32_t stats_process_id()
+        {
+        #ifdef PLATFORM_WINDOWS
+            return uint32_t(GetCurrentProcessId());
+        #else
+            return uint32_t(getpid());
+        #endif /* PLATFORM_WINDOWS */
+        }
+
+        static bool stats_process_alive(uint32_t pid)
+        {
+        #ifdef PLATFORM_WINDOWS
+            HANDLE h        = OpenProcess(SYNCHRONIZE, FALSE, DWORD(pid));
+            if (h == NULL)
+                return GetLastError() == ERROR_ACCESS_DENIED;
+            const bool alive    = WaitForSingleObject(h, 0) == WAIT_TIMEOUT;
+            CloseHandle(h);
+            return alive;
+        #else
+            return (kill(pid_t(pid), 0) == 0) || (errno != ESRCH);
+        #endif /* PLATFORM_WINDOWS */
+        }
+
+        bool gott_compressor::stats_slot_stale(const stats_slot_t *slot, uint32_t now, bool expired)
+        {
+            // The process of the owner has terminated without releasing the slot
+            if (!stats_process_alive(slot->nPid))
+                return true;
+
+            // The owner has not updated the slot for a long time
+            return (expired) && (uint32_t(now - slot->nStamp) > STATS_STALE_TIME);
+        }
+
+        gott_compressor::stats_slot_t *gott_compressor::acquire_stats_slot(uint32_t *owner)
+        {
+            rt_check();
+
+            LSPString name;
+            if ((system::get_env_var(STATS_ENV_VAR, &name) != STATUS_OK) || (name.is_empty()))
+                return NULL;
+
+            if (!sSharedLock.lock())
+                return NULL;
+            lsp_finally { sSharedLock.unlock(); };
+
+            // Map the segment once for all instances of the process
+            const size_t size   = sizeof(stats_header_t) + sizeof(stats_slot_t) * meta::gott_compressor::STATS_SLOTS;
+            if (pStatsShm == NULL)
+            {
+                ipc::SharedMem *shm = new ipc::SharedMem();
+                if (shm == NULL)
+                    return NULL;
+
+                const size_t mode   = ipc::SharedMem::SHM_READ | ipc::SharedMem::SHM_WRITE;
+                status_t res        = shm->open(&name, mode | ipc::SharedMem::SHM_CREATE, size);
+                if (res != STATUS_OK)
+                    res                 = shm->open(&name, mode, size);
+                if (res == STATUS_OK)
+                    res                 = shm->map(0, size);
+                if (res != STATUS_OK)
+                {
+                    lsp_warn("Could not map statistics segment '%s', code=%d", name.get_native(), int(res));
+                    shm->close();
+                    delete shm;
+                    return NULL;
+                }
+
+                // Initialize the header if the segment has just been created. The magic is published
+                // last, so readers never see a valid magic with the rest of the header not written
+                stats_header_t *hdr = static_cast<stats_header_t *>(shm->data());
+                if (atomic_cas(&hdr->nMagic, uint32_t(0), STATS_INIT_MAGIC))
+                {
+                    hdr->nVersion       = STATS_VERSION;
+                    hdr->nSlots         = meta::gott_compressor::STATS_SLOTS;
+                    hdr->nSlotSize      = sizeof(stats_slot_t);
+                    memset(&hdr[1], 0, size - sizeof(stats_header_t));
+
+                    std::atomic_thread_fence(std::memory_order_release);
+                    atomic_store(&hdr->nMagic, STATS_MAGIC);
+                }
+
+                // Wait for the header if it is initialized by another process
+                uint32_t magic      = atomic_load(&hdr->nMagic);
+                for (size_t i=0; (magic == STATS_INIT_MAGIC) && (i < STATS_INIT_TIME); ++i)
+                {
+                    system::sleep_msec(1);
+                    magic               = atomic_load(&hdr->nMagic);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if ((magic != STATS_MAGIC) || (hdr->nVersion != STATS_VERSION))
+                {
+                    lsp_warn("Statistics segment '%s' has unknown format", name.get_native());
+                    shm->close();
+                    delete shm;
+                    return NULL;
+                }
+
+                pStatsShm           = shm;
+            }
+
+            // Find a free slot. The slots of terminated processes are taken first, the slots which
+            // have not been updated for a long time only if there are no other slots left
+            system::time_t now;
+            system::get_time(&now);
+            const uint32_t pid  = stats_process_id();
+
+            stats_slot_t *slots = advance_ptr_bytes<stats_slot_t>(static_cast<uint8_t *>(pStatsShm->data()), sizeof(stats_header_t));
+            for (size_t pass=0; pass<2; ++pass)
+            {
+                for (size_t i=0; i<meta::gott_compressor::STATS_SLOTS; ++i)
+                {
+                    stats_slot_t *slot  = &slots[i];
+                    const uint32_t gen  = atomic_load(&slot->nOwner);
+                    if ((gen & 1) && (!stats_slot_stale(slot, uint32_t(now.seconds), pass > 0)))
+                        continue;
+
+                    // Take the next generation, the previous owner detects it and stops updating the slot
+                    const uint32_t token = (gen & 1) ? gen + 2 : gen + 1;
+                    if (!atomic_cas(&slot->nOwner, gen, token))
+                        continue;
+
+                    // Reset the statistics left by the previous owner
+                    const uint32_t serial   = slot->nSerial | 1;
+                    atomic_store(&slot->nSerial, serial);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    slot->nPid          = pid;
+                    slot->nStamp        = uint32_t(now.seconds);
+                    memset(&slot->nMode, 0, sizeof(stats_slot_t) - offsetof(stats_slot_t, nMode));
+                    std::atomic_thread_fence(std::memory_order_release);
+                    atomic_store(&slot->nSerial, uint32_t(serial + 1));
+
+                    ++nStatsRefs;
+                    *owner              = token;
+                    return slot;
+                }
+            }
+
+            return NULL;
+        }
+
+        void gott_compressor::release_stats_slot(stats_slot_t *slot, uint32_t owner)
+        {
+            rt_check();
+
+            if (!sSharedLock.lock())
+                return;
+            lsp_finally { sSharedLock.unlock(); };
+
+            // Free the slot only if it has not been taken by another instance
+            atomic_cas(&slot->nOwner, owner, uint32_t(owner + 1));
+            if ((--nStatsRefs) > 0)
+                return;
+
+            // Unmap the segment, it persists for other processes
+            if (pStatsShm != NULL)
+            {
+                pStatsShm->close();
+                delete pStatsShm;
+                pStatsShm           = NULL;
+            }
+        }
+
+        size_t gott_compressor::select_block_size(size_t host_block)
+        {
+            // Process the whole host buffer at once if it fits, stay within the allocated buffers
+            return lsp_limit(
+                align_size(host_block, 0x10),
+                meta::gott_compressor::BLOCK_SIZE_MIN,
+                meta::gott_compressor::BLOCK_SIZE_MAX);
+        }
+
         size_t gott_compressor::select_fft_rank(size_t sample_rate)
         {
             const size_t k = (sample_rate + meta::gott_compressor::FFT_XOVER_FREQ_MIN/2) / meta::gott_compressor::FFT_XOVER_FREQ_MIN;
@@ -697,40 +1516,48 @@ namespace lsp
         {
             // Determine number of channels
             size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
-            size_t fft_rank     = select_fft_rank(sr);
-            size_t bins         = 1 << fft_rank;
-            size_t max_delay    = bins + dspu::millis_to_samples(sr, meta::gott_compressor::LOOKAHEAD_MAX);
+
+            // Re-allocate delay lines and linear phase state synchronously, the loader's
+            // result for the previous sample rate will be discarded
+            {
+                const bool linear   = (sXOver.bLinear) || (xover_mode_t(pMode->value()) == XOVER_LINEAR_PHASE);
+                xover_state_t st;
+                init_xover_state(&st);
+                if (!alloc_xover_state(&st, sr, linear))
+                {
+                    free_xover_state(&st);
+                    alloc_xover_state(&st, sr, false);
+                }
+                apply_xover_state(&st);
+                free_xover_state(&st);
+            }
 
             // Update analyzer's sample rate
-            sAnalyzer.set_sample_rate(sr);
+            if (bAnalyzer)
+                sAnalyzer.set_sample_rate(sr);
             sFilters.set_sample_rate(sr);
             sProtSC.set_sample_rate(sr);
             sCounter.set_sample_rate(sr, true);
             bEnvUpdate          = true;
 
+            // Switch to the frequency grid for the new sample rate
+            freq_grid_t *grid   = acquire_freq_grid(sr);
+            if (grid != NULL)
+            {
+                if (pFreqGrid != NULL)
+                    release_freq_grid(pFreqGrid);
+                pFreqGrid           = grid;
+                vFreqBuffer         = grid->vFreqs;
+                vFreqIndexes        = grid->vIndexes;
+            }
+
             // Update channels
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c = &vChannels[i];
 
-                c->sBypass.init(sr);
+                c->sBypass.init(sr, meta::gott_compressor::BYPASS_FADE_TIME * 0.001f);
                 c->sDryEq.set_sample_rate(sr);
-                c->sDelay.init(max_delay);
-                c->sDryDelay.init(max_delay);
-                c->sAnDelay.init(bins);
-                c->sScDelay.init(bins);
-                c->sXOverDelay.init(max_delay);
-
-                // Need to re-initialize FFT crossover?
-                if (fft_rank != c->sFFTXOver.rank())
-                {
-                    c->sFFTXOver.init(fft_rank, meta::gott_compressor::BANDS_MAX);
-                    for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
-                        c->sFFTXOver.set_handler(j, process_band, this, c);
-                    c->sFFTXOver.set_rank(fft_rank);
-                    c->sFFTXOver.set_phase(float(i) / float(channels));
-                }
-                c->sFFTXOver.set_sample_rate(sr);
 
                 // Update bands
                 for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
@@ -744,9 +1571,12 @@ namespace lsp
                     b->sRejFilter.set_sample_rate(sr);
                     b->sAllFilter.set_sample_rate(sr);
 
-                    b->sEQ[0].set_sample_rate(sr);
-                    if (channels > 1)
-                        b->sEQ[1].set_sample_rate(sr);
+                    if (i == 0)
+                    {
+                        b->sEQ[0].set_sample_rate(sr);
+                        if (channels > 1)
+                            b->sEQ[1].set_sample_rate(sr);
+                    }
                 }
 
                 // Mark filters to rebuild
@@ -833,34 +1663,500 @@ namespace lsp
             sPremix.fLinkToSc   = (sPremix.pLinkToSc != NULL)   ? sPremix.pLinkToSc->value()    : GAIN_AMP_M_INF_DB;
             sPremix.fScToIn     = (sPremix.pScToIn != NULL)     ? sPremix.pScToIn->value()      : GAIN_AMP_M_INF_DB;
             sPremix.fScToLink   = (sPremix.pScToLink != NULL)   ? sPremix.pScToLink->value()    : GAIN_AMP_M_INF_DB;
+
+            // Build the mixing matrix, sidechain terms are used only by sidechain versions of the plugin
+            const float m[PM_TOTAL][PM_TOTAL] =
+            {
+                { 1.0f,                                         (bSidechain) ? sPremix.fScToIn : 0.0f,      sPremix.fLinkToIn           },
+                { (bSidechain) ? sPremix.fInToSc : 0.0f,        1.0f,                                       sPremix.fLinkToSc           },
+                { sPremix.fInToLink,                            (bSidechain) ? sPremix.fScToLink : 0.0f,    1.0f                        },
+            };
+
+            // Prune zero terms
+            for (size_t i=0; i<PM_TOTAL; ++i)
+            {
+                uint32_t mask       = 0;
+                for (size_t j=0; j<PM_TOTAL; ++j)
+                {
+                    const float k       = m[i][j];
+                    if (k > GAIN_AMP_M_INF_DB)
+                    {
+                        sPremix.vMatrix[i][j]   = k;
+                        mask               |= uint32_t(1) << j;
+                    }
+                    else
+                        sPremix.vMatrix[i][j]   = 0.0f;
+                }
+                sPremix.vMask[i]    = mask;
+            }
+        }
+
+        gott_compressor::vca_bus_t *gott_compressor::acquire_vca_bus(size_t group)
+        {
+            rt_check();
+
+            if (!sSharedLock.lock())
+                return NULL;
+            lsp_finally { sSharedLock.unlock(); };
+
+            // The bus is allocated by the first instance that joins the group
+            vca_bus_t *bus      = vVcaBuses[group - 1];
+            if (bus == NULL)
+            {
+                bus                 = static_cast<vca_bus_t *>(malloc(sizeof(vca_bus_t)));
+                if (bus == NULL)
+                    return NULL;
+
+                bus->pLeader        = NULL;
+                bus->nGroup         = group;
+                bus->nRefs          = 0;
+                bus->nHead          = 0;
+                bus->nSerial        = 0;
+                bus->nSampleRate    = 0;
+                bus->nChannels      = 0;
+                bus->nBands         = 0;
+                for (size_t i=0; i<2; ++i)
+                    for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                        dsp::fill_one(bus->vVCA[i][j], meta::gott_compressor::VCA_BUS_SIZE);
+
+                vVcaBuses[group - 1]    = bus;
+            }
+
+            ++bus->nRefs;
+            return bus;
+        }
+
+        void gott_compressor::release_vca_bus(vca_bus_t *bus)
+        {
+            if (bus == NULL)
+                return;
+
+            rt_check();
+
+            if (!sSharedLock.lock())
+                return;
+            lsp_finally { sSharedLock.unlock(); };
+
+            if ((--bus->nRefs) > 0)
+                return;
+
+            vVcaBuses[bus->nGroup - 1]  = NULL;
+            free(bus);
+        }
+
+        void gott_compressor::leave_vca_bus()
+        {
+            // Give up the leadership, followers fall back to their own detection
+            if ((bVcaLeader) && (pVcaBus != NULL))
+                atomic_cas(&pVcaBus->pLeader, this, static_cast<gott_compressor *>(NULL));
+
+            bVcaLeader          = false;
+            bVcaSync            = false;
+        }
+
+        void gott_compressor::update_vca_share()
+        {
+            const uint32_t share    = (pVcaShare != NULL) ? uint32_t(pVcaShare->value()) : VCA_SHARE_OFF;
+            const size_t group      = (pVcaGroup != NULL) ? size_t(pVcaGroup->value()) : meta::gott_compressor::VCA_GROUP_DFL;
+            const uint32_t want     = (share != VCA_SHARE_OFF) ?
+                lsp_limit(group, meta::gott_compressor::VCA_GROUP_MIN, meta::gott_compressor::VCA_GROUP_MAX) : 0;
+            const uint32_t have     = (pVcaBus != NULL) ? pVcaBus->nGroup : 0;
+
+            // Leave the previous group
+            if ((share != nVcaShare) || (want != have))
+            {
+                leave_vca_bus();
+                nVcaShare           = share;
+            }
+
+            // The bus of the new group is acquired by the loader and applied by sync_vca_bus()
+            nVcaGroup           = want;
+            if ((want != have) || (pVcaBus == NULL))
+                return;
+
+            // Try to become the leader, only one leader per group is allowed
+            if ((nVcaShare == VCA_SHARE_LEADER) && (!bVcaLeader))
+                bVcaLeader          = atomic_cas(&pVcaBus->pLeader, static_cast<gott_compressor *>(NULL), this);
+            if (bVcaLeader)
+                vca_bus_publish();
+        }
+
+        void gott_compressor::vca_bus_publish()
+        {
+            // Only the leader modifies the format, so it can be read without synchronization
+            vca_bus_t *bus          = pVcaBus;
+            const uint32_t channels = (nMode == GOTT_MONO) ? 1 : 2;
+            if ((bus->nSampleRate == fSampleRate) && (bus->nChannels == channels) && (bus->nBands == nBands))
+                return;
+
+            // Begin update: followers retry while the serial is odd or has changed
+            const uint32_t serial   = bus->nSerial;
+            atomic_store(&bus->nSerial, uint32_t(serial + 1));
+            std::atomic_thread_fence(std::memory_order_release);
+
+            bus->nSampleRate        = fSampleRate;
+            bus->nChannels          = channels;
+            bus->nBands             = nBands;
+
+            // Commit update
+            std::atomic_thread_fence(std::memory_order_release);
+            atomic_store(&bus->nSerial, uint32_t(serial + 2));
+        }
+
+        bool gott_compressor::read_vca_format(const vca_bus_t *bus, uint32_t *sample_rate, uint32_t *channels, uint32_t *bands)
+        {
+            uint32_t *serial    = const_cast<uint32_t *>(&bus->nSerial);
+
+            for (size_t i=0; i<VCA_FORMAT_ATTEMPTS; ++i)
+            {
+                const uint32_t s1   = atomic_load(serial);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s1 & 1)
+                    continue;
+
+                *sample_rate        = bus->nSampleRate;
+                *channels           = bus->nChannels;
+                *bands              = bus->nBands;
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (atomic_load(serial) == s1)
+                    return true;
+            }
+
+            return false;
+        }
+
+        void gott_compressor::sync_vca_bus()
+        {
+            if (pVcaLoader == NULL)
+                return;
+
+            // Take the result of the loader, the previous bus is released by the loader on next run
+            if (pVcaLoader->completed())
+            {
+                pVcaLoader->reset();
+
+                leave_vca_bus();
+                pVcaBusGarbage      = pVcaBus;
+                pVcaBus             = pVcaBusNew;
+                pVcaBusNew          = NULL;
+                update_vca_share();
+            }
+
+            // Request the loader if the bus does not match the group
+            if (!pVcaLoader->idle())
+                return;
+            const uint32_t have     = (pVcaBus != NULL) ? pVcaBus->nGroup : 0;
+            if (nVcaGroup == have)
+                return;
+
+            ipc::IExecutor *executor    = pWrapper->executor();
+            if (executor == NULL)
+                return;
+
+            // Allocation of the bus is not RT-safe, sharing starts when the loader completes
+            lsp_trace("Deferring detector sharing bus for group=%d to the loader", int(nVcaGroup));
+            nVcaGroupNew        = nVcaGroup;
+            executor->submit(pVcaLoader);
+        }
+
+        void gott_compressor::vca_bus_write(size_t channel, size_t band, const float *src, size_t samples)
+        {
+            // Only the leader modifies the head, so it can be read without synchronization
+            float * const buf   = pVcaBus->vVCA[channel][band];
+            const size_t head   = pVcaBus->nHead & (meta::gott_compressor::VCA_BUS_SIZE - 1);
+            const size_t tail   = lsp_min(meta::gott_compressor::VCA_BUS_SIZE - head, samples);
+
+            if (src != NULL)
+            {
+                dsp::copy(&buf[head], src, tail);
+                dsp::copy(buf, &src[tail], samples - tail);
+            }
+            else
+            {
+                dsp::fill_one(&buf[head], tail);
+                dsp::fill_one(buf, samples - tail);
+            }
+        }
+
+        void gott_compressor::vca_bus_commit(size_t samples)
+        {
+            // Publish the format and the data written to the ring buffers
+            vca_bus_publish();
+            atomic_store(&pVcaBus->nHead, uint32_t(pVcaBus->nHead + samples));
+        }
+
+        bool gott_compressor::vca_bus_read(size_t samples)
+        {
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            const bool follow       = vca_bus_fetch(samples);
+
+            // Remember the last value received from the leader to fade out from it when the leader is lost
+            for (size_t i=0; i<channels; ++i)
+            {
+                for (size_t j=0; j<nBands; ++j)
+                {
+                    band_vca_t *v           = &vChannels[i].vVca[j];
+                    if (follow)
+                        v->fVcaHold             = v->vLeader[samples - 1];
+                    else if (fVcaMix > 0.0f)
+                        dsp::fill(v->vLeader, v->fVcaHold, samples);
+                }
+            }
+
+            return follow;
+        }
+
+        bool gott_compressor::vca_bus_fetch(size_t samples)
+        {
+            static constexpr uint32_t max_lag   = meta::gott_compressor::VCA_BUS_SIZE - meta::gott_compressor::BLOCK_SIZE_MAX;
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+
+            vca_bus_t *bus          = pVcaBus;
+            if ((nVcaShare != VCA_SHARE_FOLLOWER) || (bus == NULL) || (bus->nGroup != nVcaGroup))
+                return false;
+            uint32_t sample_rate, bus_channels, bus_bands;
+            if ((atomic_load(&bus->pLeader) == NULL) ||
+                (!read_vca_format(bus, &sample_rate, &bus_channels, &bus_bands)) ||
+                (sample_rate != fSampleRate))
+            {
+                bVcaSync                = false;
+                return false;
+            }
+
+            // Synchronize with the leader: start from the latest published block
+            const uint32_t head     = atomic_load(&bus->nHead);
+            if ((!bVcaSync) || (uint32_t(head - nVcaTail) > max_lag))
+            {
+                nVcaTail                = head - samples;
+                bVcaSync                = true;
+            }
+
+            // The leader has not published enough data yet, use own detection
+            if (uint32_t(head - nVcaTail) < samples)
+            {
+                bVcaSync                = false;
+                return false;
+            }
+
+            const size_t src_channels   = lsp_limit(bus_channels, 1u, 2u);
+            const size_t src_bands      = lsp_min(bus_bands, uint32_t(meta::gott_compressor::BANDS_MAX));
+            const size_t pos            = nVcaTail & (meta::gott_compressor::VCA_BUS_SIZE - 1);
+            const size_t tail           = lsp_min(meta::gott_compressor::VCA_BUS_SIZE - pos, samples);
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                const size_t src_ch     = lsp_min(i, src_channels - 1);
+
+                for (size_t j=0; j<nBands; ++j)
+                {
+                    band_vca_t *v           = &vChannels[i].vVca[j];
+                    if (j >= src_bands)
+                    {
+                        dsp::fill_one(v->vLeader, samples);
+                        continue;
+                    }
+
+                    const float *buf        = bus->vVCA[src_ch][j];
+                    dsp::copy(v->vLeader, &buf[pos], tail);
+                    dsp::copy(&v->vLeader[tail], buf, samples - tail);
+                }
+            }
+
+            // Drop the data if the leader has overwritten it while reading
+            if (uint32_t(atomic_load(&bus->nHead) - nVcaTail) > max_lag)
+            {
+                bVcaSync                = false;
+                return false;
+            }
+
+            nVcaTail               += samples;
+            return true;
+        }
+
+        void gott_compressor::publish_stats(size_t samples, const system::time_t *start)
+        {
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            stats_slot_t *st        = pStats;
+
+            // The slot has been taken by another instance as stale
+            if (atomic_load(&st->nOwner) != nStatsOwner)
+                return;
+
+            // Compute DSP time and its ratio to the duration of the block
+            system::time_t end;
+            system::get_time(&end);
+            const float time        = (end.seconds - start->seconds) * 1e+6f + (end.nanos - start->nanos) * 1e-3f;
+            const float duration    = (fSampleRate > 0) ? (samples * 1e+6f) / fSampleRate : 0.0f;
+            const float load        = (duration > 0.0f) ? time / duration : 0.0f;
+
+            // Begin update: readers retry while the serial is odd or has changed.
+            // The odd serial should become visible before any of the data
+            const uint32_t serial   = st->nSerial;
+            atomic_store(&st->nSerial, uint32_t(serial + 1));
+            std::atomic_thread_fence(std::memory_order_release);
+
+            st->nStamp              = uint32_t(end.seconds);
+            st->nXOver              = enXOver;
+            st->nBands              = nBands;
+            st->nSampleRate         = fSampleRate;
+            st->nBlocks            += 1;
+            if (load > 1.0f)
+                st->nOverloads         += 1;
+            st->fDspTime            = time;
+            st->fDspTimeMax         = lsp_max(st->fDspTimeMax, time);
+            st->fLoad               = load;
+            st->fLoadMax            = lsp_max(st->fLoadMax, load);
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                const channel_t *c      = &vChannels[i];
+                st->vInLevel[i]         = c->pInLvl->value();
+                st->vOutLevel[i]        = c->pOutLvl->value();
+
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                {
+                    const band_ports_t *bp  = c->vBands[j].pPorts;
+                    st->vGain[i][j]         = bp->pMeterGain->value();
+                    st->vCurve[i][j]        = bp->pCurveLvl->value();
+                }
+            }
+
+            // Commit update: all data should become visible before the even serial
+            std::atomic_thread_fence(std::memory_order_release);
+            atomic_store(&st->nSerial, uint32_t(serial + 2));
+        }
+
+        bool gott_compressor::read_stats_slot(const stats_slot_t *slot, stats_slot_t *dst, size_t attempts)
+        {
+            uint32_t *serial    = const_cast<uint32_t *>(&slot->nSerial);
+
+            for (size_t i=0; i<attempts; ++i)
+            {
+                // The data should not be read before the serial
+                const uint32_t s1   = atomic_load(serial);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s1 & 1)
+                    continue;
+
+                memcpy(dst, slot, sizeof(stats_slot_t));
+
+                // The data should be read completely before the serial is checked again
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (atomic_load(serial) == s1)
+                    return true;
+            }
+
+            return false;
+        }
+
+        float gott_compressor::refresh_budget()
+        {
+            // The budget is read once for the process
+            struct budget_t
+            {
+                float   fValue;
+
+                budget_t()
+                {
+                    LSPString value;
+                    fValue          = 0.0f;
+                    if (system::get_env_var(REFRESH_BUDGET_ENV_VAR, &value) != STATUS_OK)
+                        return;
+
+                    // The value should not depend on the locale of the host
+                    SET_LOCALE_SCOPED(LC_NUMERIC, "C");
+                    const char *str = value.get_utf8();
+                    char *end       = NULL;
+                    errno           = 0;
+                    const double v  = strtod(str, &end);
+                    if ((errno != 0) || (end == str) || (!(v > 0.0)))
+                        return;
+                    for ( ; (*end == ' ') || (*end == '\t'); ++end) {}
+                    if (*end == '\0')
+                        fValue          = v;
+                }
+            };
+
+            static const budget_t budget;
+            return budget.fValue;
+        }
+
+        void gott_compressor::update_refresh_rate()
+        {
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+
+            // Estimate the activity as the maximum ratio between the current levels
+            // and the levels at the previous refresh
+            float activity          = 1.0f;
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                const float in          = c->pInLvl->value();
+                const float out         = c->pOutLvl->value();
+
+                activity                = lsp_max(activity, lsp_max(in, c->fRefreshIn) / lsp_max(lsp_min(in, c->fRefreshIn), GAIN_AMP_M_72_DB));
+                activity                = lsp_max(activity, lsp_max(out, c->fRefreshOut) / lsp_max(lsp_min(out, c->fRefreshOut), GAIN_AMP_M_72_DB));
+                c->fRefreshIn           = in;
+                c->fRefreshOut          = out;
+
+                for (size_t j=0; j<nBands; ++j)
+                {
+                    band_t *b               = &c->vBands[j];
+                    const float gain        = c->vVca[j].fGainLevel;
+                    activity                = lsp_max(activity, lsp_max(gain, b->fRefreshGain) / lsp_max(lsp_min(gain, b->fRefreshGain), GAIN_AMP_M_72_DB));
+                    b->fRefreshGain         = gain;
+                }
+            }
+
+            // Jump to the maximum rate on fast changes, slow down while the data is static
+            float rate              = fRefreshRate;
+            if (activity >= meta::gott_compressor::REFRESH_ACTIVITY_HIGH)
+                rate                    = meta::gott_compressor::REFRESH_RATE;
+            else if (activity <= meta::gott_compressor::REFRESH_ACTIVITY_LOW)
+                rate                    = rate * 0.5f;
+            else
+                rate                    = rate * 2.0f;
+
+            // Share the global budget between all instances
+            const float budget      = refresh_budget();
+            if (budget > 0.0f)
+                rate                    = lsp_min(rate, budget / lsp_max(atomic_load(&nInstances), atomic_t(1)));
+            rate                    = lsp_limit(rate, float(meta::gott_compressor::REFRESH_RATE_MIN), float(meta::gott_compressor::REFRESH_RATE));
+
+            if (rate != fRefreshRate)
+            {
+                fRefreshRate            = rate;
+                sCounter.set_frequency(rate, true);
+            }
         }
 
         void gott_compressor::update_settings()
         {
+            // Hosts call update_settings() from the audio thread
+            ++nRtDepth;
+            lsp_finally { --nRtDepth; };
+
             // Update pre-mix
             update_premix();
 
+            // Update detector sharing
+            update_vca_share();
+
             // Get common constants
             dspu::filter_params_t fp;
             size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
             bool solo_on        = false;
             bool prot_on        = pProt->value() >= 0.5f;
             bool rebuild_filters= false;
-            int active_channels = 0;
             size_t env_boost    = pEnvBoost->value();
             size_t num_bands    = (pExtraBand->value() >= 0.5f) ? meta::gott_compressor::BANDS_MAX : meta::gott_compressor::BANDS_MAX - 1;
             float sc_preamp     = pScPreamp->value();
             size_t lookahead    = dspu::millis_to_samples(fSampleRate, pLookahead->value());
 
             // Determine work mode: classic, modern or linear phase
-            xover_mode_t xover  = xover_mode_t(pMode->value());
-            if (xover != enXOver)
-            {
-                enXOver             = xover;
+            if (update_xover_mode())
                 rebuild_filters     = true;
-                for (size_t i=0; i<channels; ++i)
-                    vChannels[i].sXOverDelay.clear();
-            }
 
             // Check band and split configuration
             if (nBands != num_bands)
@@ -877,7 +2173,7 @@ namespace lsp
                     vSplits[i]          = freq;
                 }
             }
-            bStereoSplit        = (pStereoSplit != NULL) ? pStereoSplit->value() >= 0.5f : false;
+            const bool stereo_split = (pStereoSplit != NULL) ? pStereoSplit->value() >= 0.5f : false;
 
             // Store gain
             const float out_gain= pOutGain->value();
@@ -889,14 +2185,26 @@ namespace lsp
             fDryGain            = (dry_gain * drywet + 1.0f - drywet) * out_gain;
             fWetGain            = wet_gain * drywet * out_gain;
             fZoom               = pZoom->value();
+            bIDisplaySync       = true;
+            fGrTime             = (pGrTime != NULL) ? pGrTime->value() : meta::gott_compressor::GR_HISTORY_TIME_DFL;
 
             nScType             = decode_sidechain_type(pScMode->value());
-            plug::IPort *sc     = (bStereoSplit) ? pScSpSource : pScSource;
+            pProcessBlock       = select_process_block(enXOver, nScType);
+            plug::IPort *sc     = (stereo_split) ? pScSpSource : pScSource;
             size_t sc_src       = (sc != NULL) ? sc->value() : dspu::SCS_MIDDLE;
+            size_t sc_mode      = pScMode->value();
 
             float max_attack    = meta::gott_compressor::ATTACK_TIME_MIN;
             float sc_react      = pScReact->value();
 
+            // Check that sidechain settings have changed
+            const bool sc_update=
+                (sc_mode != nScMode) ||
+                (sc_src != nScSource) ||
+                (sc_react != fScReact) ||
+                (stereo_split != bStereoSplit);
+            bStereoSplit        = stereo_split;
+
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c = &vChannels[i];
@@ -905,79 +2213,125 @@ namespace lsp
                 if (rebuild_filters)
                     c->bRebuildFilers       = true;
 
-                // Update bypass settings
-                c->sBypass.set_bypass(pBypass->value());
-
                 // Update analyzer settings
                 c->bInFft               = c->pFftInSw->value() >= 0.5f;
                 c->bOutFft              = c->pFftOutSw->value() >= 0.5f;
 
-                sAnalyzer.enable_channel(c->nAnInChannel, c->bInFft);
-                sAnalyzer.enable_channel(c->nAnOutChannel, c->pFftOutSw->value()  >= 0.5f);
-
-                if (sAnalyzer.channel_active(c->nAnInChannel))
-                    active_channels ++;
-                if (sAnalyzer.channel_active(c->nAnOutChannel))
-                    active_channels ++;
-
                 // Update bands
                 for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                 {
+                    band_vca_t *v           = &c->vVca[j];
                     band_t *b               = &c->vBands[j];
 
                     // Update solo/mute options
-                    bool enabled            = (j < nBands) && (b->pEnabled->value() >= 0.5f);
-                    bool mute               = (b->pMute->value() >= 0.5f);
-                    bool solo               = (b->pSolo->value() >= 0.5f);
+                    bool enabled            = (j < nBands) && (b->pPorts->pEnabled->value() >= 0.5f);
+                    bool mute               = (b->pPorts->pMute->value() >= 0.5f);
+                    bool solo               = (b->pPorts->pSolo->value() >= 0.5f);
+
+                    // Solo of one band affects muting of others, so it is resolved for all bands
+                    v->bMute                = mute;
+                    if (solo)
+                        solo_on                 = true;
+
+                    // Read processor settings
+                    float attack            = b->pPorts->pAttackTime->value();
+                    float release           = b->pPorts->pReleaseTime->value();
+                    float makeup            = b->pPorts->pMakeup->value();
+                    float up_ratio          = b->pPorts->pUpRatio->value();
+                    float down_ratio        = b->pPorts->pDownRatio->value();
+                    float down_thresh       = b->pPorts->pDownThresh->value();
+                    float up_thresh         = b->pPorts->pUpThresh->value();
+                    float min_thresh        = b->pPorts->pMinThresh->value();
+                    float knee              = b->pPorts->pKnee->value();
+
+                    max_attack              = lsp_max(max_attack, attack);
+
+                    // Skip the band if neither its own nor the shared sidechain settings have changed,
+                    // the sample rate update also leaves the dynamics processor modified
+                    b->bDirty               =
+                        (sc_update) ||
+                        (bEnvUpdate) ||
+                        (b->sProc.modified()) ||
+                        (sc_preamp != fScPreamp) ||
+                        (v->bEnabled != enabled) ||
+                        (b->bMuteSw != mute) ||
+                        (b->bSolo != solo) ||
+                        (b->fAttackTime != attack) ||
+                        (b->fReleaseTime != release) ||
+                        (v->fMakeup != makeup) ||
+                        (b->fUpRatio != up_ratio) ||
+                        (b->fDownRatio != down_ratio) ||
+                        (b->fDownThresh != down_thresh) ||
+                        (b->fUpThresh != up_thresh) ||
+                        (b->fMinThresh != min_thresh) ||
+                        (b->fKnee != knee);
+                    if (!b->bDirty)
+                        continue;
 
                     // Update sidechain settings
-                    b->sSC.set_mode(pScMode->value());
-                    b->sSC.set_reactivity(sc_react);
-                    b->sSC.set_stereo_mode((nMode == GOTT_MS) ? dspu::SCSM_MIDSIDE : dspu::SCSM_STEREO);
-                    b->sSC.set_source(decode_sidechain_source(sc_src, bStereoSplit, i));
+                    if (sc_update)
+                    {
+                        b->sSC.set_mode(sc_mode);
+                        b->sSC.set_reactivity(sc_react);
+                        b->sSC.set_stereo_mode((nMode == GOTT_MS) ? dspu::SCSM_MIDSIDE : dspu::SCSM_STEREO);
+                        b->sSC.set_source(decode_sidechain_source(sc_src, bStereoSplit, i));
+                    }
 
                     if (sc_preamp != fScPreamp)
                         b->nSync       |= S_EQ_CURVE;
 
-                    // Update processor settings
-                    float attack            = b->pAttackTime->value();
-                    float makeup            = b->pMakeup->value();
-                    float up_ratio          = b->pUpRatio->value();
-                    float down_ratio        = b->pDownRatio->value();
-                    float f_down_gain       = b->pDownThresh->value();
-                    float knee              = b->pKnee->value();
-                    float f_up_gain         = lsp_min(b->pUpThresh->value(), f_down_gain * 0.999f);
-                    float f_min_gain        = lsp_min(b->pMinThresh->value(), f_up_gain * 0.999f);
-                    float f_min_value       = f_up_gain - (f_up_gain - f_min_gain) / up_ratio;
-
-                    max_attack              = lsp_max(max_attack, attack);
+                    // Update timings of the dynamics processor
+                    if ((b->fAttackTime != attack) || (b->fReleaseTime != release))
+                    {
+                        b->sProc.set_attack_time(0, attack);
+                        b->sProc.set_release_time(0, release);
 
-                    // Update dynamics processor
-                    b->sProc.set_attack_time(0, attack);
-                    b->sProc.set_release_time(0, b->pReleaseTime->value());
-                    b->sProc.set_dot(0, f_down_gain, f_down_gain, knee);
-                    b->sProc.set_dot(1, f_up_gain, f_up_gain, knee);
-                    b->sProc.set_dot(2, f_min_gain, f_min_value, knee);
-                    b->sProc.set_dot(3, NULL);
+                        b->fAttackTime      = attack;
+                        b->fReleaseTime     = release;
+                    }
 
-                    b->sProc.set_in_ratio(1.0f);
-                    b->sProc.set_out_ratio(down_ratio);
+                    // Update the curve of the dynamics processor
+                    if ((b->fDownThresh != down_thresh) ||
+                        (b->fUpThresh != up_thresh) ||
+                        (b->fMinThresh != min_thresh) ||
+                        (b->fUpRatio != up_ratio) ||
+                        (b->fDownRatio != down_ratio) ||
+                        (b->fKnee != knee))
+                    {
+                        float f_down_gain       = down_thresh;
+                        float f_up_gain         = lsp_min(up_thresh, f_down_gain * 0.999f);
+                        float f_min_gain        = lsp_min(min_thresh, f_up_gain * 0.999f);
+                        float f_min_value       = f_up_gain - (f_up_gain - f_min_gain) / up_ratio;
+
+                        b->sProc.set_dot(0, f_down_gain, f_down_gain, knee);
+                        b->sProc.set_dot(1, f_up_gain, f_up_gain, knee);
+                        b->sProc.set_dot(2, f_min_gain, f_min_value, knee);
+                        b->sProc.set_dot(3, NULL);
+
+                        b->sProc.set_in_ratio(1.0f);
+                        b->sProc.set_out_ratio(down_ratio);
+
+                        b->fDownThresh      = down_thresh;
+                        b->fUpThresh        = up_thresh;
+                        b->fMinThresh       = min_thresh;
+                        b->fUpRatio         = up_ratio;
+                        b->fDownRatio       = down_ratio;
+                        b->fKnee            = knee;
+                    }
 
-                    if ((b->sProc.modified()) || (b->fMakeup != makeup))
+                    if ((b->sProc.modified()) || (v->fMakeup != makeup))
                     {
                         b->sProc.update_settings();
-                        b->fMakeup      = makeup;
+                        v->fMakeup      = makeup;
                         b->nSync       |= S_COMP_CURVE;
                     }
-                    if ((b->bSolo != solo) || (b->bMute != mute) || (b->bEnabled != enabled))
+                    if ((b->bSolo != solo) || (b->bMuteSw != mute) || (v->bEnabled != enabled))
                     {
                         b->bSolo        = solo;
-                        b->bMute        = mute;
-                        b->bEnabled     = enabled;
+                        b->bMuteSw      = mute;
+                        v->bEnabled     = enabled;
                         b->nSync       |= S_COMP_CURVE;
                     }
-                    if (solo)
-                        solo_on         = true;
                 }
 
                 // Update envelope boost filters
@@ -1023,16 +2377,28 @@ namespace lsp
             }
 
             // Update surge protection sidechain settings
-            sProtSC.set_mode(pScMode->value());
-            sProtSC.set_reactivity(sc_react);
-            sProtSC.set_stereo_mode(dspu::SCSM_STEREO);
-            sProtSC.set_source(dspu::SCS_AMAX);
+            if (sc_update)
+            {
+                sProtSC.set_mode(sc_mode);
+                sProtSC.set_reactivity(sc_react);
+                sProtSC.set_stereo_mode(dspu::SCSM_STEREO);
+                sProtSC.set_source(dspu::SCS_AMAX);
+            }
 
             // Update surge protection
-            sProt.set_on_threshold(GAIN_AMP_M_96_DB);
-            sProt.set_off_threshold(meta::gott_compressor::THRESH_MIN_MIN * GAIN_AMP_M_12_DB);
-            sProt.set_transition_time(dspu::millis_to_samples(fSampleRate, max_attack + sc_react) * meta::gott_compressor::PROT_ATTACK_MUL);
-            sProt.set_shutdown_time(dspu::millis_to_samples(fSampleRate, meta::gott_compressor::PROT_SHUTDOWN_TIME));
+            if ((sc_update) || (max_attack != fMaxAttack) || (bEnvUpdate))
+            {
+                sProt.set_on_threshold(GAIN_AMP_M_96_DB);
+                sProt.set_off_threshold(meta::gott_compressor::THRESH_MIN_MIN * GAIN_AMP_M_12_DB);
+                sProt.set_transition_time(dspu::millis_to_samples(fSampleRate, max_attack + sc_react) * meta::gott_compressor::PROT_ATTACK_MUL);
+                sProt.set_shutdown_time(dspu::millis_to_samples(fSampleRate, meta::gott_compressor::PROT_SHUTDOWN_TIME));
+            }
+
+            // Commit the sidechain state
+            nScMode         = sc_mode;
+            nScSource       = sc_src;
+            fScReact        = sc_react;
+            fMaxAttack      = max_attack;
 
             // Commit the envelope state
             fScPreamp       = sc_preamp;
@@ -1041,22 +2407,7 @@ namespace lsp
             bProt           = prot_on;
 
             // Update analyzer parameters
-            sAnalyzer.set_reactivity(pReactivity->value());
-            if (pShiftGain != NULL)
-                sAnalyzer.set_shift(pShiftGain->value() * 100.0f);
-            sAnalyzer.set_activity(active_channels > 0);
-
-            // Update analyzer
-            if (sAnalyzer.needs_reconfiguration())
-            {
-                sAnalyzer.reconfigure();
-                sAnalyzer.get_frequencies(
-                    vFreqBuffer,
-                    vFreqIndexes,
-                    SPEC_FREQ_MIN,
-                    SPEC_FREQ_MAX,
-                    meta::gott_compressor::FFT_MESH_POINTS);
-            }
+            update_analyzer();
 
             // Second pass over filter
             for (size_t i=0; i<channels; ++i)
@@ -1066,190 +2417,938 @@ namespace lsp
                 // Check muting option
                 for (size_t j=0; j<nBands; ++j)
                 {
-                    band_t *b       = &c->vBands[j];
-                    if ((!b->bMute) && (solo_on))
-                        b->bMute        = !b->bSolo;
+                    band_vca_t *v   = &c->vVca[j];
+                    if ((!v->bMute) && (solo_on))
+                        v->bMute        = !c->vBands[j].bSolo;
                 }
+            }
 
-                // Rebuild compression plan
-                if (c->bRebuildFilers)
-                {
-                    // Configure equalizers
-                    for (size_t j=0; j<nBands; ++j)
-                    {
-                        band_t *b           = &c->vBands[j];
-                        size_t band         = b - c->vBands;
+            // Rebuild compression plan
+            update_filters();
 
-                        float freq_start    = (j > 0) ? vSplits[j-1] : 0.0f;
-                        float freq_end      = (j < (nBands - 1)) ? vSplits[j] : fSampleRate * 0.5f;
+            // Report latency
+            update_latency(lookahead);
 
-                        b->nSync           |= S_EQ_CURVE | S_BAND_CURVE;
+            // Update bypass state
+            if (pBypass->value() >= 0.5f)
+            {
+                if ((nBypassState == BYP_ACTIVE) || (nBypassState == BYP_WARM_UP))
+                {
+                    // Cross-fade to the dry signal and suspend processing after the delay
+                    nBypassState        = BYP_FADE_OUT;
+                    nBypassCounter      = bypass_fade_samples();
+                }
+            }
+            else if (nBypassState == BYP_FADE_OUT)
+            {
+                // Cross-fade back to the processed signal
+                nBypassState        = BYP_ACTIVE;
+                nBypassCounter      = bypass_fade_samples();
+            }
+            else if (nBypassState == BYP_SUSPENDED)
+            {
+                // Resume processing and keep the dry signal until delay lines are filled
+                // and envelopes have settled
+                nBypassState        = BYP_WARM_UP;
+                nBypassCounter      = warm_up_samples();
 
-                        lsp_trace("band[%d] start=%f, end=%f", int(j), freq_start, freq_end);
+                // Only the taps read by the next blocks contain stale data
+                for (size_t i=0; i<channels; ++i)
+                {
+                    channel_t *c    = &vChannels[i];
 
-                        // Configure equalizer for the sidechain
-                        for (size_t k=0; k<channels; ++k)
-                        {
-                            // Configure lo-pass filter
-                            fp.nType        = (j != (nBands-1)) ? dspu::FLT_BT_LRX_LOPASS : dspu::FLT_NONE;
-                            fp.fFreq        = freq_end;
-                            fp.fFreq2       = fp.fFreq;
-                            fp.fQuality     = 0.0f;
-                            fp.fGain        = 1.0f;
-                            fp.fQuality     = 0.0f;
-                            fp.nSlope       = 2;
+                    delay_clear(&c->sDelay, DL_MAIN, c->sDelay.nLookahead + c->sDelay.nXOver);
+                    delay_clear(&c->sDelay, DL_SC, c->sDelay.nXOver);
+                }
+            }
 
-                            b->sEQ[k].set_params(0, &fp);
+            for (size_t i=0; i<channels; ++i)
+                vChannels[i].sBypass.set_bypass(nBypassState != BYP_ACTIVE);
+        }
 
-                            // Configure hi-pass filter
-                            fp.nType        = (j != 0) ? dspu::FLT_BT_LRX_HIPASS : dspu::FLT_NONE;
-                            fp.fFreq        = freq_start;
-                            fp.fFreq2       = fp.fFreq;
-                            fp.fQuality     = 0.0f;
-                            fp.fGain        = 1.0f;
-                            fp.fQuality     = 0.0f;
-                            fp.nSlope       = 2;
+        bool gott_compressor::update_xover_mode()
+        {
+            // Keep the current mode until the linear phase state is allocated
+            xover_mode_t xover  = xover_mode_t(pMode->value());
+            if ((xover == XOVER_LINEAR_PHASE) && (!sXOver.bLinear))
+                xover               = (enXOver != XOVER_LINEAR_PHASE) ? enXOver : XOVER_MODERN;
+            if (xover == enXOver)
+                return false;
 
-                            b->sEQ[k].set_params(1, &fp);
-                        }
+            enXOver             = xover;
+            return true;
+        }
 
-                        // Update transfer function for equalizer
-                        b->sEQ[0].freq_chart(b->vSidechainBuffer, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
-                        dsp::pcomplex_mod(b->vSidechainBuffer, b->vSidechainBuffer, meta::gott_compressor::FFT_MESH_POINTS);
+        void gott_compressor::update_analyzer()
+        {
+            if (!bAnalyzer)
+                return;
+
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            size_t active_channels  = 0;
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                sAnalyzer.enable_channel(c->nAnInChannel, c->bInFft);
+                sAnalyzer.enable_channel(c->nAnOutChannel, c->bOutFft);
+
+                if (sAnalyzer.channel_active(c->nAnInChannel))
+                    active_channels ++;
+                if (sAnalyzer.channel_active(c->nAnOutChannel))
+                    active_channels ++;
+            }
+
+            sAnalyzer.set_reactivity(pReactivity->value());
+            if (pShiftGain != NULL)
+                sAnalyzer.set_shift(pShiftGain->value() * 100.0f);
+            sAnalyzer.set_activity(active_channels > 0);
+
+            // Update analyzer
+            if (sAnalyzer.needs_reconfiguration())
+                sAnalyzer.reconfigure();
+        }
+
+        void gott_compressor::update_filters()
+        {
+            dspu::filter_params_t fp;
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c    = &vChannels[i];
+                if (!c->bRebuildFilers)
+                    continue;
+
+                // Configure equalizers
+                for (size_t j=0; j<nBands; ++j)
+                {
+                    band_t *b           = &c->vBands[j];
+                    size_t band         = b - c->vBands;
+
+                    float freq_start    = (j > 0) ? vSplits[j-1] : 0.0f;
+                    float freq_end      = (j < (nBands - 1)) ? vSplits[j] : fSampleRate * 0.5f;
+
+                    b->nSync           |= S_EQ_CURVE | S_BAND_CURVE;
+
+                    lsp_trace("band[%d] start=%f, end=%f", int(j), freq_start, freq_end);
+
+                    // Configure equalizer for the sidechain, only equalizers of the first channel are used
+                    band_t *sb          = &vChannels[0].vBands[j];
+                    for (size_t k=0; (i == 0) && (k<channels); ++k)
+                    {
+                        // Configure lo-pass filter
+                        fp.nType        = (j != (nBands-1)) ? dspu::FLT_BT_LRX_LOPASS : dspu::FLT_NONE;
+                        fp.fFreq        = freq_end;
+                        fp.fFreq2       = fp.fFreq;
+                        fp.fQuality     = 0.0f;
+                        fp.fGain        = 1.0f;
+                        fp.fQuality     = 0.0f;
+                        fp.nSlope       = 2;
+
+                        sb->sEQ[k].set_params(0, &fp);
+
+                        // Configure hi-pass filter
+                        fp.nType        = (j != 0) ? dspu::FLT_BT_LRX_HIPASS : dspu::FLT_NONE;
+                        fp.fFreq        = freq_start;
+                        fp.fFreq2       = fp.fFreq;
+                        fp.fQuality     = 0.0f;
+                        fp.fGain        = 1.0f;
+                        fp.fQuality     = 0.0f;
+                        fp.nSlope       = 2;
+
+                        sb->sEQ[k].set_params(1, &fp);
+                    }
 
-                        // Update filter parameters, depending on operating mode
-                        if (enXOver == XOVER_MODERN)
+                    // Update transfer function for equalizer
+                    sb->sEQ[0].freq_chart(vTr, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
+                    dsp::pcomplex_mod(b->vSidechainBuffer, vTr, meta::gott_compressor::FFT_MESH_POINTS);
+
+                    // Update filter parameters, depending on operating mode
+                    if (enXOver == XOVER_MODERN)
+                    {
+                        // Configure filter for band
+                        if (j <= 0)
                         {
-                            // Configure filter for band
-                            if (j <= 0)
-                            {
-                                fp.nType        = dspu::FLT_BT_LRX_LOSHELF;
-                                fp.fFreq        = freq_end;
-                                fp.fFreq2       = freq_end;
-                            }
-                            else if (j >= (nBands - 1))
-                            {
-                                fp.nType        = dspu::FLT_BT_LRX_HISHELF;
-                                fp.fFreq        = freq_start;
-                                fp.fFreq2       = freq_start;
-                            }
-                            else
-                            {
-                                fp.nType        = dspu::FLT_BT_LRX_LADDERPASS;
-                                fp.fFreq        = freq_start;
-                                fp.fFreq2       = freq_end;
-                            }
+                            fp.nType        = dspu::FLT_BT_LRX_LOSHELF;
+                            fp.fFreq        = freq_end;
+                            fp.fFreq2       = freq_end;
+                        }
+                        else if (j >= (nBands - 1))
+                        {
+                            fp.nType        = dspu::FLT_BT_LRX_HISHELF;
+                            fp.fFreq        = freq_start;
+                            fp.fFreq2       = freq_start;
+                        }
+                        else
+                        {
+                            fp.nType        = dspu::FLT_BT_LRX_LADDERPASS;
+                            fp.fFreq        = freq_start;
+                            fp.fFreq2       = freq_end;
+                        }
+
+                        fp.fGain        = 1.0f;
+                        fp.nSlope       = 2;
+                        fp.fQuality     = 0.0;
+
+                        lsp_trace("Filter type=%d, from=%f, to=%f", int(fp.nType), fp.fFreq, fp.fFreq2);
+
+                        sFilters.set_params(c->vVca[j].nFilterID, &fp);
+                        sFilters.set_filter_active(c->vVca[j].nFilterID, j < nBands);
+                    }
+                    else if (enXOver == XOVER_CLASSIC)
+                    {
+                        fp.fGain        = 1.0f;
+                        fp.nSlope       = 2;
+                        fp.fQuality     = 0.0;
+                        fp.fFreq        = freq_end;
+                        fp.fFreq2       = freq_end;
+
+                        // We're going from low frequencies to high frequencies
+                        if (j >= (nBands - 1))
+                        {
+                            fp.nType    = dspu::FLT_NONE;
+                            b->sPassFilter.update(fSampleRate, &fp);
+                            b->sRejFilter.update(fSampleRate, &fp);
+                            b->sAllFilter.update(fSampleRate, &fp);
+                        }
+                        else
+                        {
+                            fp.nType    = dspu::FLT_BT_LRX_LOPASS;
+                            b->sPassFilter.update(fSampleRate, &fp);
+                            fp.nType    = dspu::FLT_BT_LRX_HIPASS;
+                            b->sRejFilter.update(fSampleRate, &fp);
+                            fp.nType    = (j == 0) ? dspu::FLT_NONE : dspu::FLT_BT_LRX_ALLPASS;
+                            b->sAllFilter.update(fSampleRate, &fp);
+                        }
+                    }
+                    else // enXOver == XOVER_LINEAR_PHASE
+                    {
+                        if (j > 0)
+                        {
+                            c->pFFTXOver->enable_hpf(band, true);
+                            c->pFFTXOver->set_hpf_frequency(band, freq_start);
+                            c->pFFTXOver->set_hpf_slope(band, -48.0f);
+                        }
+                        else
+                            c->pFFTXOver->disable_hpf(band);
+
+                        if (j < (nBands-1))
+                        {
+                            c->pFFTXOver->enable_lpf(band, true);
+                            c->pFFTXOver->set_lpf_frequency(band, freq_end);
+                            c->pFFTXOver->set_lpf_slope(band, -48.0f);
+                        }
+                        else
+                            c->pFFTXOver->disable_lpf(band);
+                    }
+                }
+
+                // Enable/disable bands in FFT crossover
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                {
+                    band_t *b       = &c->vBands[j];
+                    size_t band     = b - c->vBands;
+                    if (c->pFFTXOver != NULL)
+                        c->pFFTXOver->enable_band(band, j < nBands);
+                }
+
+                // Set-up all-pass filters for the 'dry' chain which can be mixed with the 'wet' chain.
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX-1; ++j)
+                {
+                    band_t *b       = (j < (nBands-1)) ? &c->vBands[j] : NULL;
+                    fp.nType        = (b != NULL) ? dspu::FLT_BT_LRX_ALLPASS : dspu::FLT_NONE;
+                    fp.fFreq        = (b != NULL) ? vSplits[j] : 0.0f;
+                    fp.fFreq2       = fp.fFreq;
+                    fp.fGain        = 1.0f;
+                    fp.nSlope       = 2;
+                    fp.fQuality     = 0.0f;
+
+                    c->sDryEq.set_params(j, &fp);
+                }
+
+                // Cleanup flag indicating that filters should be rebuilt
+                c->bRebuildFilers   = false;
+            }
+        }
+
+        void gott_compressor::update_latency(size_t lookahead)
+        {
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            size_t xover_latency    = (enXOver == XOVER_LINEAR_PHASE) ? vChannels[0].pFFTXOver->latency() : 0;
+
+            set_latency(lookahead + xover_latency);
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c    = &vChannels[i];
+
+                c->sDelay.nLookahead    = lookahead;
+                c->sDelay.nXOver        = xover_latency;
+            }
+        }
+
+        void gott_compressor::process_band(void *object, void *subject, size_t band, const float *data, size_t sample, size_t count)
+        {
+            channel_t *c            = static_cast<channel_t *>(subject);
+            band_vca_t *v           = &c->vVca[band];
+
+            // Store data to band's buffer
+            dsp::copy(&v->vBuffer[sample], data, count);
+        }
+
+        void gott_compressor::delay_write(delay_line_t *dl, size_t lane, const float *src, size_t count)
+        {
+            float * const buf   = dl->vLane[lane];
+            const size_t size   = dl->vSize[lane];
+            const size_t head   = dl->vHead[lane];
+            const size_t tail   = size - head;
+
+            if (count <= tail)
+                dsp::copy(&buf[head], src, count);
+            else
+            {
+                dsp::copy(&buf[head], src, tail);
+                dsp::copy(buf, &src[tail], count - tail);
+            }
+
+            dl->vHead[lane]     = (count < tail) ? head + count : head + count - size;
+        }
+
+        void gott_compressor::history_push(grh_level_t *levels, const float *src, size_t count)
+        {
+            constexpr size_t mask   = meta::gott_compressor::GR_HISTORY_POINTS - 1;
+
+            for (size_t offset=0; offset < count; )
+            {
+                // Accumulate samples of the first level cell, NULL source means unit gain
+                grh_level_t *lv     = &levels[0];
+                const size_t n      = lsp_min(count - offset, meta::gott_compressor::GR_HISTORY_DECIM - lv->nCount);
+                float min           = GAIN_AMP_0_DB;
+                float max           = GAIN_AMP_0_DB;
+                if (src != NULL)
+                    dsp::minmax(&src[offset], n, &min, &max);
+
+                lv->fMin            = (lv->nCount > 0) ? lsp_min(lv->fMin, min) : min;
+                lv->fMax            = (lv->nCount > 0) ? lsp_max(lv->fMax, max) : max;
+                lv->nCount         += n;
+                offset             += n;
+                if (lv->nCount < meta::gott_compressor::GR_HISTORY_DECIM)
+                    continue;
+
+                // The cell is complete: store it and propagate to upper levels, each
+                // cell of the upper level combines two cells of the lower level
+                for (size_t k=0; k<meta::gott_compressor::GR_HISTORY_LEVELS; ++k)
+                {
+                    lv                  = &levels[k];
+                    if (k > 0)
+                    {
+                        lv->fMin            = (lv->nCount > 0) ? lsp_min(lv->fMin, min) : min;
+                        lv->fMax            = (lv->nCount > 0) ? lsp_max(lv->fMax, max) : max;
+                        if ((++lv->nCount) < 2)
+                            break;
+                    }
+
+                    min                 = lv->fMin;
+                    max                 = lv->fMax;
+                    const size_t pos    = lv->nHead & mask;
+                    lv->vMin[pos]       = min;
+                    lv->vMax[pos]       = max;
+                    lv->nHead          += 1;
+                    lv->nCount          = 0;
+                }
+            }
+        }
+
+        void gott_compressor::history_fetch(const grh_level_t *levels, float *min, float *max, size_t level, size_t cells, size_t points)
+        {
+            // Resample the last cells of the level to the mesh points, the level is selected
+            // to have not more cells than points, so each point refers to one cell
+            constexpr size_t mask   = meta::gott_compressor::GR_HISTORY_POINTS - 1;
+            const grh_level_t *lv   = &levels[level];
+            const size_t first      = lv->nHead - cells;
+
+            for (size_t i=0; i<points; ++i)
+            {
+                const size_t pos    = (first + (i * cells) / points) & mask;
+                min[i]              = lv->vMin[pos];
+                max[i]              = lv->vMax[pos];
+            }
+        }
+
+        void gott_compressor::delay_read(const delay_line_t *dl, size_t lane, float *dst, size_t delay, size_t count)
+        {
+            // Read the last written block delayed by the specified number of samples
+            const float * const buf = dl->vLane[lane];
+            const size_t size   = dl->vSize[lane];
+            size_t pos          = dl->vHead[lane] + size - count - delay;
+            if (pos >= size)
+                pos                -= size;
+            const size_t tail   = size - pos;
+
+            if (count <= tail)
+                dsp::copy(dst, &buf[pos], count);
+            else
+            {
+                dsp::copy(dst, &buf[pos], tail);
+                dsp::copy(&dst[tail], buf, count - tail);
+            }
+        }
+
+        void gott_compressor::delay_clear(delay_line_t *dl, size_t lane, size_t count)
+        {
+            // Clear the specified number of samples written last
+            float * const buf   = dl->vLane[lane];
+            const size_t size   = dl->vSize[lane];
+            if ((buf == NULL) || (count <= 0))
+                return;
+
+            count               = lsp_min(count, size);
+            const size_t head   = dl->vHead[lane];
+            if (count <= head)
+                dsp::fill_zero(&buf[head - count], count);
+            else
+            {
+                dsp::fill_zero(buf, head);
+                dsp::fill_zero(&buf[size + head - count], count - head);
+            }
+        }
+
+        void gott_compressor::init_xover_state(xover_state_t *st)
+        {
+            for (size_t i=0; i<2; ++i)
+                st->vXOver[i]       = NULL;
+            st->pDelayData      = NULL;
+            st->nDataSize       = 0;
+            for (size_t i=0; i<DL_TOTAL; ++i)
+                st->vLaneSize[i]    = 0;
+            st->nSampleRate     = 0;
+            st->bLinear         = false;
+        }
+
+        void gott_compressor::free_xover_state(xover_state_t *st)
+        {
+            rt_check();
+
+            for (size_t i=0; i<2; ++i)
+            {
+                if (st->vXOver[i] == NULL)
+                    continue;
+                st->vXOver[i]->destroy();
+                delete st->vXOver[i];
+                st->vXOver[i]       = NULL;
+            }
+
+            if (st->pDelayData != NULL)
+            {
+                free_aligned(st->pDelayData);
+                st->pDelayData      = NULL;
+            }
+            st->nDataSize       = 0;
+        }
+
+        bool gott_compressor::alloc_xover_state(xover_state_t *st, size_t sr, bool linear)
+        {
+            rt_check();
+
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            const size_t fft_rank   = select_fft_rank(sr);
+            const size_t bins       = (linear) ? size_t(1) << fft_rank : 0;
+            const size_t lookahead  = dspu::millis_to_samples(sr, meta::gott_compressor::LOOKAHEAD_MAX);
+
+            st->nSampleRate     = sr;
+            st->bLinear         = linear;
+
+            // Delay lines need to hold the crossover latency only in linear phase mode
+            st->vLaneSize[DL_MAIN]  = lookahead + bins + meta::gott_compressor::BLOCK_SIZE_MAX;
+            st->vLaneSize[DL_DRY]   = lookahead + bins + meta::gott_compressor::BLOCK_SIZE_MAX;
+            st->vLaneSize[DL_SC]    = bins + meta::gott_compressor::BLOCK_SIZE_MAX;
+
+            // Delay lines keep the history and are sized for the largest block
+            size_t szof_delay   = 0;
+            for (size_t j=0; j<DL_TOTAL; ++j)
+                szof_delay         += align_size(sizeof(float) * st->vLaneSize[j], OPTIMAL_ALIGN);
+            szof_delay         *= channels;
+
+            uint8_t *ptr        = alloc_aligned<uint8_t>(st->pDelayData, szof_delay);
+            if (ptr == NULL)
+                return false;
+            st->nDataSize       = szof_delay;
+            dsp::fill_zero(reinterpret_cast<float *>(ptr), szof_delay / sizeof(float));
+
+            if (!linear)
+                return true;
+
+            // Initialize FFT crossovers
+            for (size_t i=0; i<channels; ++i)
+            {
+                dspu::FFTCrossover *xover   = new dspu::FFTCrossover();
+                if (xover == NULL)
+                    return false;
+                st->vXOver[i]       = xover;
+
+                if (!xover->init(fft_rank, meta::gott_compressor::BANDS_MAX))
+                    return false;
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                    xover->set_handler(j, process_band, this, &vChannels[i]);
+                xover->set_rank(fft_rank);
+                xover->set_phase(float(i) / float(channels));
+                xover->set_sample_rate(sr);
+            }
+
+            return true;
+        }
+
+        void gott_compressor::apply_xover_state(xover_state_t *st)
+        {
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+
+            // Exchange the states, the caller becomes owner of the previous state
+            xover_state_t tmp   = sXOver;
+            sXOver              = *st;
+            *st                 = tmp;
+
+            // Bind channels to the new state
+            uint8_t *ptr        = (sXOver.pDelayData != NULL) ? align_ptr(sXOver.pDelayData, DEFAULT_ALIGN) : NULL;
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                c->pFFTXOver        = sXOver.vXOver[i];
+                for (size_t j=0; j<DL_TOTAL; ++j)
+                {
+                    const size_t size   = sXOver.vLaneSize[j];
+                    c->sDelay.vLane[j]  = (ptr != NULL) ? advance_ptr_bytes<float>(ptr, align_size(sizeof(float) * size, OPTIMAL_ALIGN)) : NULL;
+                    c->sDelay.vSize[j]  = (ptr != NULL) ? size : 0;
+                    c->sDelay.vHead[j]  = 0;
+                }
+
+                c->bRebuildFilers   = true;
+            }
+        }
+
+        void gott_compressor::sync_xover_state()
+        {
+            if (pXOverLoader == NULL)
+                return;
+
+            const bool linear   = xover_mode_t(pMode->value()) == XOVER_LINEAR_PHASE;
+
+            // Take the result of the loader
+            if (pXOverLoader->completed())
+            {
+                const bool valid    =
+                    (pXOverLoader->successful()) &&
+                    (sXOverNew.bLinear == linear) &&
+                    (sXOverNew.nSampleRate == fSampleRate);
+
+                pXOverLoader->reset();
+                if (valid)
+                    apply_xover_state(&sXOverNew);
+
+                // The loader will free the unused state on next run
+                sXOverGarbage       = sXOverNew;
+                init_xover_state(&sXOverNew);
+
+                // Apply the crossover mode without the full update of settings
+                if (valid)
+                {
+                    update_xover_mode();
+                    pProcessBlock       = select_process_block(enXOver, nScType);
+                    update_filters();
+                    update_latency(vChannels[0].sDelay.nLookahead);
+                }
+            }
+
+            // Request the loader if the state does not match the configuration
+            if (!pXOverLoader->idle())
+                return;
+            if ((sXOver.bLinear == linear) && (sXOver.nSampleRate == fSampleRate))
+                return;
+
+            ipc::IExecutor *executor    = pWrapper->executor();
+            if (executor == NULL)
+                return;
+
+            // Building the crossover state is not RT-safe, the change takes effect when the loader completes
+            lsp_trace("Deferring crossover state for linear=%d, sample_rate=%d to the loader", int(linear), int(fSampleRate));
+            sXOverNew.nSampleRate   = fSampleRate;
+            sXOverNew.bLinear       = linear;
+            executor->submit(pXOverLoader);
+        }
+
+        void gott_compressor::init_block_state(block_state_t *st)
+        {
+            st->pData           = NULL;
+            st->nDataSize       = 0;
+            st->nBlockSize      = 0;
+        }
+
+        void gott_compressor::free_block_state(block_state_t *st)
+        {
+            rt_check();
+
+            if (st->pData != NULL)
+            {
+                free_aligned(st->pData);
+                st->pData           = NULL;
+            }
+            st->nDataSize       = 0;
+        }
+
+        bool gott_compressor::alloc_block_state(block_state_t *st, size_t block)
+        {
+            rt_check();
+
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            const size_t szof_buffer= align_size(sizeof(float) * block, OPTIMAL_ALIGN);
+            const size_t to_alloc   =
+                szof_buffer +       // vBuffer
+                szof_buffer +       // vProtBuffer
+                szof_buffer*2 +     // vSC[2]
+                szof_buffer +       // vEnv
+                (
+                    szof_buffer * 3 + // sPremix
+                    szof_buffer +   // vInBuffer for each channel
+                    szof_buffer +   // vBuffer for each channel
+                    szof_buffer +   // vScBuffer for each channel
+                    szof_buffer +   // vInAnalyze each channel
+                    (
+                        szof_buffer +   // vVCA
+                        szof_buffer +   // vLeader
+                        szof_buffer     // vBuffer
+                    ) * meta::gott_compressor::BANDS_MAX
+                ) * channels;
+
+            uint8_t *ptr        = alloc_aligned<uint8_t>(st->pData, to_alloc, OPTIMAL_ALIGN);
+            if (ptr == NULL)
+                return false;
+            st->nDataSize       = to_alloc;
+            st->nBlockSize      = block;
+            dsp::fill_zero(reinterpret_cast<float *>(ptr), to_alloc / sizeof(float));
+
+            return true;
+        }
+
+        void gott_compressor::apply_block_state(block_state_t *st)
+        {
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+
+            // Exchange the states, the caller becomes owner of the previous state
+            block_state_t tmp   = sBlock;
+            sBlock              = *st;
+            *st                 = tmp;
+
+            // Bind buffers to the new state, none of them keeps data between blocks
+            const size_t szof_buffer = align_size(sizeof(float) * sBlock.nBlockSize, OPTIMAL_ALIGN);
+            uint8_t *ptr        = align_ptr(sBlock.pData, OPTIMAL_ALIGN);
+
+            vBuffer             = advance_ptr_bytes<float>(ptr, szof_buffer);
+            vProtBuffer         = advance_ptr_bytes<float>(ptr, szof_buffer);
+            vSC[0]              = advance_ptr_bytes<float>(ptr, szof_buffer);
+            vSC[1]              = advance_ptr_bytes<float>(ptr, szof_buffer);
+            vEnv                = advance_ptr_bytes<float>(ptr, szof_buffer);
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                sPremix.vTmpIn[i]   = advance_ptr_bytes<float>(ptr, szof_buffer);
+                sPremix.vTmpLink[i] = advance_ptr_bytes<float>(ptr, szof_buffer);
+                sPremix.vTmpSc[i]   = advance_ptr_bytes<float>(ptr, szof_buffer);
+
+                c->vInBuffer        = advance_ptr_bytes<float>(ptr, szof_buffer);
+                c->vBuffer          = advance_ptr_bytes<float>(ptr, szof_buffer);
+                c->vScBuffer        = advance_ptr_bytes<float>(ptr, szof_buffer);
+                c->vInAnalyze       = advance_ptr_bytes<float>(ptr, szof_buffer);
+                vSCIn[i]            = c->vScBuffer;
+
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                {
+                    band_vca_t *v       = &c->vVca[j];
+                    v->vVCA             = advance_ptr_bytes<float>(ptr, szof_buffer);
+                    v->vLeader          = advance_ptr_bytes<float>(ptr, szof_buffer);
+                    v->vBuffer          = advance_ptr_bytes<float>(ptr, szof_buffer);
+                }
+            }
+
+            nBlockSize          = lsp_min(nBlockSize, sBlock.nBlockSize);
+        }
+
+        void gott_compressor::sync_block_state(size_t samples)
+        {
+            // Follow the largest host buffer immediately, let it shrink when the largest
+            // buffer of the last window is smaller
+            nHostPeak           = lsp_max(nHostPeak, samples);
+            nHostBlock          = lsp_max(nHostBlock, samples);
+            nHostTime          += samples;
+            if (nHostTime >= dspu::seconds_to_samples(fSampleRate, meta::gott_compressor::BLOCK_SIZE_WINDOW))
+            {
+                nHostBlock          = nHostPeak;
+                nHostPeak           = 0;
+                nHostTime           = 0;
+            }
+            const size_t block  = select_block_size(nHostBlock);
+
+            if (pBlockLoader != NULL)
+            {
+                // Take the result of the loader
+                if (pBlockLoader->completed())
+                {
+                    const bool valid    = pBlockLoader->successful();
+                    pBlockLoader->reset();
+                    if (valid)
+                        apply_block_state(&sBlockNew);
+
+                    // The loader will free the unused state on next run
+                    sBlockGarbage       = sBlockNew;
+                    init_block_state(&sBlockNew);
+                }
+
+                // Request the loader if the buffers do not match the host buffer size
+                ipc::IExecutor *executor    = pWrapper->executor();
+                if ((pBlockLoader->idle()) && (sBlock.nBlockSize != block) && (executor != NULL))
+                {
+                    // Allocation is not RT-safe, the buffers of the current size are used until the loader completes
+                    sBlockNew.nBlockSize    = block;
+                    executor->submit(pBlockLoader);
+                }
+            }
+
+            nBlockSize          = lsp_min(block, sBlock.nBlockSize);
+        }
+
+        bool gott_compressor::init_analyzer()
+        {
+            rt_check();
+
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+
+            if (!sAnalyzer.init(2*channels, meta::gott_compressor::FFT_RANK,
+                                MAX_SAMPLE_RATE, meta::gott_compressor::REFRESH_RATE))
+                return false;
+
+            sAnalyzer.set_rank(meta::gott_compressor::FFT_RANK);
+            sAnalyzer.set_activity(false);
+            sAnalyzer.set_envelope(dspu::envelope::WHITE_NOISE);
+            sAnalyzer.set_window(meta::gott_compressor::FFT_WINDOW);
+            sAnalyzer.set_rate(meta::gott_compressor::REFRESH_RATE);
+            sAnalyzer.set_sample_rate(fSampleRate);
+            sAnalyzer.reconfigure();
+
+            return true;
+        }
+
+        void gott_compressor::sync_analyzer()
+        {
+            if ((bAnalyzer) || (pAnLoader == NULL))
+                return;
+
+            // Take the result of the loader
+            if (pAnLoader->completed())
+            {
+                const bool valid    = pAnLoader->successful();
+                pAnLoader->reset();
+                if (!valid)
+                    return;
+
+                // The sample rate may have changed while loading
+                bAnalyzer           = true;
+                sAnalyzer.set_sample_rate(fSampleRate);
+                update_analyzer();
+                return;
+            }
+
+            // Request the loader on first UI activation
+            if ((!bAnRequest) || (!pAnLoader->idle()))
+                return;
+
+            ipc::IExecutor *executor    = pWrapper->executor();
+            if (executor == NULL)
+                return;
+
+            // Initialization of the analyzer is not RT-safe, the analysis starts when the loader completes
+            lsp_trace("Deferring analyzer initialization to the loader");
+            executor->submit(pAnLoader);
+        }
+
+        void gott_compressor::dump_xover_state(dspu::IStateDumper *v, const char *name, const xover_state_t *st)
+        {
+            v->begin_object(name, st, sizeof(xover_state_t));
+            {
+                v->begin_array("vXOver", st->vXOver, 2);
+                {
+                    for (size_t i=0; i<2; ++i)
+                        v->write_object(st->vXOver[i]);
+                }
+                v->end_array();
+                v->write("pDelayData", st->pDelayData);
+                v->write("nDataSize", st->nDataSize);
+                v->writev("vLaneSize", st->vLaneSize, DL_TOTAL);
+                v->write("nSampleRate", st->nSampleRate);
+                v->write("bLinear", st->bLinear);
+            }
+            v->end_object();
+        }
+
+        void gott_compressor::dump_block_state(dspu::IStateDumper *v, const char *name, const block_state_t *st)
+        {
+            v->begin_object(name, st, sizeof(block_state_t));
+            {
+                v->write("pData", st->pData);
+                v->write("nDataSize", st->nDataSize);
+                v->write("nBlockSize", st->nBlockSize);
+            }
+            v->end_object();
+        }
+
+        //---------------------------------------------------------------------
+        gott_compressor::CoreTask::CoreTask(gott_compressor *core)
+        {
+            pCore           = core;
+            nState          = CORE_TASK_IDLE;
+        }
+
+        gott_compressor::CoreTask::~CoreTask()
+        {
+            pCore           = NULL;
+        }
+
+        bool gott_compressor::CoreTask::enter()
+        {
+            return atomic_cas(&nState, CORE_TASK_IDLE, CORE_TASK_BUSY);
+        }
+
+        void gott_compressor::CoreTask::leave()
+        {
+            atomic_store(&nState, CORE_TASK_IDLE);
+        }
+
+        bool gott_compressor::CoreTask::cancel()
+        {
+            return atomic_cas(&nState, CORE_TASK_IDLE, CORE_TASK_CANCELLED);
+        }
+
+        bool gott_compressor::CoreTask::cancelled() const
+        {
+            return atomic_load(&nState) == CORE_TASK_CANCELLED;
+        }
+
+        bool gott_compressor::CoreTask::busy() const
+        {
+            return atomic_load(&nState) == CORE_TASK_BUSY;
+        }
+
+        //---------------------------------------------------------------------
+        gott_compressor::XOverLoader::XOverLoader(gott_compressor *core): CoreTask(core)
+        {
+        }
+
+        gott_compressor::XOverLoader::~XOverLoader()
+        {
+        }
+
+        status_t gott_compressor::XOverLoader::run()
+        {
+            if (!enter())
+                return STATUS_CANCELLED;
+            lsp_finally { leave(); };
+
+            // Free the state left from the previous run
+            free_xover_state(&pCore->sXOverGarbage);
+
+            // Allocate new state
+            xover_state_t *st   = &pCore->sXOverNew;
+            if (!pCore->alloc_xover_state(st, st->nSampleRate, st->bLinear))
+            {
+                free_xover_state(st);
+                return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        //---------------------------------------------------------------------
+        gott_compressor::BlockLoader::BlockLoader(gott_compressor *core): CoreTask(core)
+        {
+        }
 
-                            fp.fGain        = 1.0f;
-                            fp.nSlope       = 2;
-                            fp.fQuality     = 0.0;
+        gott_compressor::BlockLoader::~BlockLoader()
+        {
+        }
 
-                            lsp_trace("Filter type=%d, from=%f, to=%f", int(fp.nType), fp.fFreq, fp.fFreq2);
+        status_t gott_compressor::BlockLoader::run()
+        {
+            if (!enter())
+                return STATUS_CANCELLED;
+            lsp_finally { leave(); };
 
-                            sFilters.set_params(b->nFilterID, &fp);
-                            sFilters.set_filter_active(b->nFilterID, j < nBands);
-                        }
-                        else if (enXOver == XOVER_CLASSIC)
-                        {
-                            fp.fGain        = 1.0f;
-                            fp.nSlope       = 2;
-                            fp.fQuality     = 0.0;
-                            fp.fFreq        = freq_end;
-                            fp.fFreq2       = freq_end;
+            // Free the buffers left from the previous run
+            free_block_state(&pCore->sBlockGarbage);
 
-                            // We're going from low frequencies to high frequencies
-                            if (j >= (nBands - 1))
-                            {
-                                fp.nType    = dspu::FLT_NONE;
-                                b->sPassFilter.update(fSampleRate, &fp);
-                                b->sRejFilter.update(fSampleRate, &fp);
-                                b->sAllFilter.update(fSampleRate, &fp);
-                            }
-                            else
-                            {
-                                fp.nType    = dspu::FLT_BT_LRX_LOPASS;
-                                b->sPassFilter.update(fSampleRate, &fp);
-                                fp.nType    = dspu::FLT_BT_LRX_HIPASS;
-                                b->sRejFilter.update(fSampleRate, &fp);
-                                fp.nType    = (j == 0) ? dspu::FLT_NONE : dspu::FLT_BT_LRX_ALLPASS;
-                                b->sAllFilter.update(fSampleRate, &fp);
-                            }
-                        }
-                        else // enXOver == XOVER_LINEAR_PHASE
-                        {
-                            if (j > 0)
-                            {
-                                c->sFFTXOver.enable_hpf(band, true);
-                                c->sFFTXOver.set_hpf_frequency(band, freq_start);
-                                c->sFFTXOver.set_hpf_slope(band, -48.0f);
-                            }
-                            else
-                                c->sFFTXOver.disable_hpf(band);
+            // Allocate new buffers
+            block_state_t *st   = &pCore->sBlockNew;
+            if (!pCore->alloc_block_state(st, st->nBlockSize))
+            {
+                free_block_state(st);
+                return STATUS_NO_MEM;
+            }
 
-                            if (j < (nBands-1))
-                            {
-                                c->sFFTXOver.enable_lpf(band, true);
-                                c->sFFTXOver.set_lpf_frequency(band, freq_end);
-                                c->sFFTXOver.set_lpf_slope(band, -48.0f);
-                            }
-                            else
-                                c->sFFTXOver.disable_lpf(band);
-                        }
-                    }
+            return STATUS_OK;
+        }
 
-                    // Enable/disable bands in FFT crossover
-                    for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
-                    {
-                        band_t *b       = &c->vBands[j];
-                        size_t band     = b - c->vBands;
-                        c->sFFTXOver.enable_band(band, j < nBands);
-                    }
+        //---------------------------------------------------------------------
+        gott_compressor::VcaLoader::VcaLoader(gott_compressor *core): CoreTask(core)
+        {
+        }
 
-                    // Set-up all-pass filters for the 'dry' chain which can be mixed with the 'wet' chain.
-                    for (size_t j=0; j<meta::gott_compressor::BANDS_MAX-1; ++j)
-                    {
-                        band_t *b       = (j < (nBands-1)) ? &c->vBands[j] : NULL;
-                        fp.nType        = (b != NULL) ? dspu::FLT_BT_LRX_ALLPASS : dspu::FLT_NONE;
-                        fp.fFreq        = (b != NULL) ? vSplits[j] : 0.0f;
-                        fp.fFreq2       = fp.fFreq;
-                        fp.fGain        = 1.0f;
-                        fp.nSlope       = 2;
-                        fp.fQuality     = 0.0f;
+        gott_compressor::VcaLoader::~VcaLoader()
+        {
+        }
 
-                        c->sDryEq.set_params(j, &fp);
-                    }
+        status_t gott_compressor::VcaLoader::run()
+        {
+            if (!enter())
+                return STATUS_CANCELLED;
+            lsp_finally { leave(); };
 
-                    // Cleanup flag indicating that filters should be rebuilt
-                    c->bRebuildFilers   = false;
-                }
-            }
+            // Release the bus left from the previous run
+            release_vca_bus(pCore->pVcaBusGarbage);
+            pCore->pVcaBusGarbage   = NULL;
 
-            // Report latency
-            size_t xover_latency = (enXOver == XOVER_LINEAR_PHASE) ? vChannels[0].sFFTXOver.latency() : 0;
+            // Acquire the bus of the requested group
+            const uint32_t group    = pCore->nVcaGroupNew;
+            if (group == 0)
+                return STATUS_OK;
 
-            set_latency(lookahead + xover_latency);
-            for (size_t i=0; i<channels; ++i)
-            {
-                channel_t *c    = &vChannels[i];
+            pCore->pVcaBusNew       = acquire_vca_bus(group);
+            return (pCore->pVcaBusNew != NULL) ? STATUS_OK : STATUS_NO_MEM;
+        }
 
-                c->sDelay.set_delay(lookahead);
-                c->sDryDelay.set_delay(lookahead + xover_latency);
-                c->sAnDelay.set_delay(xover_latency);
-                c->sScDelay.set_delay(xover_latency);
-                c->sXOverDelay.set_delay(xover_latency);
-            }
+        //---------------------------------------------------------------------
+        gott_compressor::AnalyzerLoader::AnalyzerLoader(gott_compressor *core): CoreTask(core)
+        {
         }
 
-        void gott_compressor::process_band(void *object, void *subject, size_t band, const float *data, size_t sample, size_t count)
+        gott_compressor::AnalyzerLoader::~AnalyzerLoader()
         {
-            channel_t *c            = static_cast<channel_t *>(subject);
-            band_t *b               = &c->vBands[band];
+        }
 
-            // Store data to band's buffer
-            dsp::copy(&b->vBuffer[sample], data, count);
+        status_t gott_compressor::AnalyzerLoader::run()
+        {
+            if (!enter())
+                return STATUS_CANCELLED;
+            lsp_finally { leave(); };
+
+            if (!pCore->init_analyzer())
+            {
+                pCore->sAnalyzer.destroy();
+                return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
         }
 
-        void gott_compressor::process_sidechain(size_t samples)
+        void gott_compressor::process_premix(size_t samples)
         {
             const size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
 
@@ -1263,10 +3362,7 @@ namespace lsp
                 float * const sc_buf    = sPremix.vSc[i];
                 float * const link_buf  = sPremix.vLink[i];
 
-                c->vIn                  = in_buf;
                 c->vOut                 = out_buf;
-                c->vScIn                = sc_buf;
-                c->vShmIn               = link_buf;
 
                 sPremix.vIn[i]   += samples;
                 sPremix.vOut[i]  += samples;
@@ -1275,101 +3371,30 @@ namespace lsp
                 if (sPremix.vLink[i] != NULL)
                     sPremix.vLink[i] += samples;
 
-                // Perform transformation
-                if (bSidechain)
-                {
-                    // (Sc, Link) -> In
-                    if ((sc_buf != NULL) && (sPremix.fScToIn > GAIN_AMP_M_INF_DB))
-                    {
-                        c->vIn              = sPremix.vTmpIn[i];
-                        dsp::fmadd_k4(c->vIn, in_buf, sc_buf, sPremix.fScToIn, samples);
-
-                        if ((link_buf != NULL) && (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB))
-                            dsp::fmadd_k3(c->vIn, link_buf, sPremix.fLinkToIn, samples);
-                    }
-                    else if ((link_buf != NULL) && (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB))
-                    {
-                        c->vIn              = sPremix.vTmpIn[i];
-                        dsp::fmadd_k4(c->vIn, in_buf, link_buf, sPremix.fLinkToIn, samples);
-                    }
-
-                    // (In, Link) -> Sc
-                    if (sPremix.fInToSc > GAIN_AMP_M_INF_DB)
-                    {
-                        c->vScIn            = sPremix.vTmpSc[i];
-                        if (sc_buf != NULL)
-                            dsp::fmadd_k4(c->vScIn, sc_buf, in_buf, sPremix.fInToSc, samples);
-                        else
-                            dsp::mul_k3(c->vScIn, in_buf, sPremix.fInToSc, samples);
-
-                        if ((link_buf != NULL) && (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB))
-                            dsp::fmadd_k3(c->vScIn, link_buf, sPremix.fLinkToSc, samples);
-                    }
-                    else if ((link_buf != NULL) && (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB))
-                    {
-                        c->vScIn            = sPremix.vTmpSc[i];
-                        if (sc_buf != NULL)
-                            dsp::fmadd_k4(c->vScIn, sc_buf, link_buf, sPremix.fLinkToSc, samples);
-                        else
-                            dsp::mul_k3(c->vScIn, link_buf, sPremix.fLinkToSc, samples);
-                    }
+                // Perform transformation, only sources that are present take part in the mix
+                float * const src[PM_TOTAL] = { in_buf, sc_buf, link_buf };
+                const uint32_t avail    =
+                    (uint32_t(1) << PM_IN) |
+                    ((sc_buf != NULL) ? (uint32_t(1) << PM_SC) : 0) |
+                    ((link_buf != NULL) ? (uint32_t(1) << PM_LINK) : 0);
 
-                    // (In, Sc) -> Link
-                    if (sPremix.fInToLink > GAIN_AMP_M_INF_DB)
-                    {
-                        c->vShmIn           = sPremix.vTmpLink[i];
-                        if (link_buf != NULL)
-                            dsp::fmadd_k4(c->vShmIn, link_buf, in_buf, sPremix.fInToLink, samples);
-                        else
-                            dsp::mul_k3(c->vShmIn, in_buf, sPremix.fInToLink, samples);
+                c->vIn                  = premix_row(sPremix.vTmpIn[i], src, sPremix.vMatrix[PM_IN], sPremix.vMask[PM_IN] & avail, PM_IN, samples);
+                c->vScIn                = premix_row(sPremix.vTmpSc[i], src, sPremix.vMatrix[PM_SC], sPremix.vMask[PM_SC] & avail, PM_SC, samples);
+                c->vShmIn               = premix_row(sPremix.vTmpLink[i], src, sPremix.vMatrix[PM_LINK], sPremix.vMask[PM_LINK] & avail, PM_LINK, samples);
+            }
+        }
 
-                        if ((sc_buf != NULL) && (sPremix.fScToLink > GAIN_AMP_M_INF_DB))
-                            dsp::fmadd_k3(c->vShmIn, sc_buf, sPremix.fScToLink, samples);
-                    }
-                    else if ((sc_buf != NULL) && (sPremix.fScToLink > GAIN_AMP_M_INF_DB))
-                    {
-                        c->vShmIn           = sPremix.vTmpLink[i];
-                        if (link_buf != NULL)
-                            dsp::fmadd_k4(c->vShmIn, link_buf, sc_buf, sPremix.fScToLink, samples);
-                        else
-                            dsp::mul_k3(c->vShmIn, sc_buf, sPremix.fScToLink, samples);
-                    }
-                }
-                else
-                {
-                    // Link -> (In, Sc)
-                    if (link_buf != NULL)
-                    {
-                        // Link -> In
-                        if (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB)
-                        {
-                            c->vIn          = sPremix.vTmpIn[i];
-                            dsp::fmadd_k4(c->vIn, in_buf, link_buf, sPremix.fLinkToIn, samples);
-                        }
-                        // Link -> Sc
-                        if (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB)
-                        {
-                            c->vScIn        = sPremix.vTmpSc[i];
-                            if (sc_buf != NULL)
-                                dsp::fmadd_k4(c->vScIn, sc_buf, link_buf, sPremix.fLinkToSc, samples);
-                            else
-                                dsp::mul_k3(c->vScIn, link_buf, sPremix.fLinkToSc, samples);
-                        }
-                    }
+        template <uint32_t SCT>
+        void gott_compressor::process_sidechain(size_t samples)
+        {
+            const size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
 
-                    // In -> Link
-                    if (sPremix.fInToLink > GAIN_AMP_M_INF_DB)
-                    {
-                        c->vShmIn       = sPremix.vTmpLink[i];
-                        if (link_buf != NULL)
-                            dsp::fmadd_k4(c->vShmIn, link_buf, in_buf, sPremix.fInToLink, samples);
-                        else
-                            dsp::mul_k3(c->vShmIn, in_buf, sPremix.fInToLink, samples);
-                    }
-                }
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t * const c = &vChannels[i];
 
                 // Perform routing
-                switch (nScType)
+                switch (SCT)
                 {
                     case SCT_EXTERNAL:
                         if (c->vScIn != NULL)
@@ -1405,273 +3430,590 @@ namespace lsp
                     samples);
         }
 
-        void gott_compressor::process(size_t samples)
+        void gott_compressor::process_input(size_t samples)
+        {
+            float level[2];
+
+            switch (nMode)
+            {
+                case GOTT_MONO:
+                    level[0]    = input_mono(vChannels[0].vBuffer, vChannels[0].vIn, fInGain, samples);
+                    vChannels[0].pInLvl->set_value(level[0]);
+                    return;
+
+                case GOTT_MS:
+                    input_ms(
+                        vChannels[0].vBuffer, vChannels[1].vBuffer,
+                        vChannels[0].vIn, vChannels[1].vIn,
+                        fInGain, level, samples);
+                    break;
+
+                case GOTT_STEREO:
+                case GOTT_LR:
+                default:
+                    input_stereo(
+                        vChannels[0].vBuffer, vChannels[1].vBuffer,
+                        vChannels[0].vIn, vChannels[1].vIn,
+                        fInGain, level, samples);
+                    break;
+            }
+
+            vChannels[0].pInLvl->set_value(level[0]);
+            vChannels[1].pInLvl->set_value(level[1]);
+        }
+
+        void gott_compressor::process_output(size_t samples, float dry_gain, float wet_gain)
         {
             const size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
 
-            // Bind input signal
+            // When the bypass is off and there is no cross-fade, write the result directly to the output
+            const bool direct   = (nBypassState == BYP_ACTIVE) && (nBypassCounter <= 0);
+            float *dst[2];
+            const float *dry[2];
+            float level[2];
+
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
 
-                sPremix.vIn[i]      = c->pIn->buffer<float>();
-                sPremix.vOut[i]     = c->pOut->buffer<float>();
-                sPremix.vSc[i]      = (c->pScIn != NULL) ? c->pScIn->buffer<float>() : sPremix.vIn[i];
-                sPremix.vLink[i]    = NULL;
+                // Keep the bypass delay line filled before the output buffer gets overwritten
+                delay_write(&c->sDelay, DL_DRY, c->vIn, samples);
 
-                core::AudioBuffer *shm_buf  = (c->pShmIn != NULL) ? c->pShmIn->buffer<core::AudioBuffer>() : NULL;
-                if ((shm_buf != NULL) && (shm_buf->active()))
-                    sPremix.vLink[i]    = shm_buf->buffer();
+                // Prepare dry signal
+                dry[i]              = NULL;
+                if (bDryOn)
+                {
+                    if (enXOver == XOVER_CLASSIC)
+                        c->sDryEq.process(c->vInBuffer, c->vInBuffer, samples);
+                    dry[i]              = c->vInBuffer;
+                }
+
+                dst[i]              = (direct) ? c->vOut : c->vBuffer;
             }
 
-            // Do processing
-            for (size_t offset = 0; offset < samples;)
+            // Apply dry/wet balance and compute output level
+            switch (nMode)
             {
-                // Determine buffer size for processing
-                size_t to_process   = lsp_min(GOTT_BUFFER_SIZE, samples-offset);
+                case GOTT_MONO:
+                    level[0]    = output_mono(
+                        dst[0], vChannels[0].vBuffer, dry[0],
+                        fOldWetGain, wet_gain, fOldDryGain, dry_gain,
+                        samples);
+                    break;
+
+                case GOTT_MS:
+                    output_ms(
+                        dst[0], dst[1], vChannels[0].vBuffer, vChannels[1].vBuffer, dry[0], dry[1],
+                        fOldWetGain, wet_gain, fOldDryGain, dry_gain,
+                        level, samples);
+                    break;
+
+                case GOTT_STEREO:
+                case GOTT_LR:
+                default:
+                    output_stereo(
+                        dst[0], dst[1], vChannels[0].vBuffer, vChannels[1].vBuffer, dry[0], dry[1],
+                        fOldWetGain, wet_gain, fOldDryGain, dry_gain,
+                        level, samples);
+                    break;
+            }
 
-                // Process pre-mix and sidechain
-                process_sidechain(to_process);
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                c->pOutLvl->set_value(level[i]);
 
-                // Measure input signal level
-                for (size_t i=0; i<channels; ++i)
+                // Apply bypass
+                if (!direct)
                 {
-                    channel_t *c        = &vChannels[i];
-                    float level         = dsp::abs_max(c->vIn, to_process) * fInGain;
-                    c->pInLvl->set_value(level);
+                    delay_read(&c->sDelay, DL_DRY, vBuffer, c->sDelay.nLookahead + c->sDelay.nXOver, samples);
+                    c->sBypass.process(c->vOut, vBuffer, c->vBuffer, samples);
                 }
+            }
+        }
 
-                // Pre-process channel data
-                if (nMode == GOTT_MS)
-                {
-                    dsp::lr_to_ms(vChannels[0].vBuffer, vChannels[1].vBuffer, vChannels[0].vIn, vChannels[1].vIn, to_process);
-                    dsp::mul_k2(vChannels[0].vBuffer, fInGain, to_process);
-                    dsp::mul_k2(vChannels[1].vBuffer, fInGain, to_process);
-                }
-                else if (nMode == GOTT_MONO)
-                    dsp::mul_k3(vChannels[0].vBuffer, vChannels[0].vIn, fInGain, to_process);
-                else
+        void gott_compressor::process_suspended(size_t samples)
+        {
+            const size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                // Measure input signal level
+                float level         = dsp::abs_max(c->vIn, samples) * fInGain;
+                c->pInLvl->set_value(level);
+
+                // Pass the dry signal with latency compensation
+                delay_write(&c->sDelay, DL_DRY, c->vIn, samples);
+                delay_read(&c->sDelay, DL_DRY, c->vOut, c->sDelay.nLookahead + c->sDelay.nXOver, samples);
+
+                // Measure output signal level
+                level               = dsp::abs_max(c->vOut, samples);
+                c->pOutLvl->set_value(level);
+
+                // Reset band meters
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                 {
-                    dsp::mul_k3(vChannels[0].vBuffer, vChannels[0].vIn, fInGain, to_process);
-                    dsp::mul_k3(vChannels[1].vBuffer, vChannels[1].vIn, fInGain, to_process);
+                    band_t *b           = &c->vBands[j];
+
+                    b->pPorts->pEnvLvl->set_value(0.0f);
+                    b->pPorts->pCurveLvl->set_value(0.0f);
+                    b->pPorts->pMeterGain->set_value(GAIN_AMP_0_DB);
                 }
+            }
+        }
 
-                // Do frequency boost and input channel analysis
+        void gott_compressor::update_bypass_state(size_t samples)
+        {
+            if (nBypassCounter > samples)
+            {
+                nBypassCounter     -= samples;
+                return;
+            }
+            nBypassCounter      = 0;
+
+            const size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
+            if (nBypassState == BYP_FADE_OUT)
+            {
+                // Bypass cross-fade is complete, suspend processing
+                nBypassState        = BYP_SUSPENDED;
+            }
+            else if (nBypassState == BYP_WARM_UP)
+            {
+                // Warm-up is complete, start cross-fade to the processed signal
+                nBypassState        = BYP_ACTIVE;
+                nBypassCounter      = bypass_fade_samples();
                 for (size_t i=0; i<channels; ++i)
-                {
-                    channel_t *c        = &vChannels[i];
-                    c->sEnvBoost[0].process(c->vScBuffer, c->vScBuffer, to_process);
-                    c->sAnDelay.process(c->vInAnalyze, c->vBuffer, to_process);
-                    c->sScDelay.process(c->vScBuffer, c->vScBuffer, to_process);
-                    vAnalyze[c->nAnInChannel] = c->vInAnalyze;
-                }
+                    vChannels[i].sBypass.set_bypass(false);
+            }
+        }
+
+        template <uint32_t XOVER, uint32_t SCT>
+        void gott_compressor::process_block(size_t samples)
+        {
+            const size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
+
+            // Process sidechain
+            process_sidechain<SCT>(samples);
+
+            // Pre-process channel data and measure input signal level
+            process_input(samples);
+
+            // Do frequency boost and input channel analysis
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                c->sEnvBoost[0].process(c->vScBuffer, c->vScBuffer, samples);
+                delay_write(&c->sDelay, DL_MAIN, c->vBuffer, samples);
+                delay_write(&c->sDelay, DL_SC, c->vScBuffer, samples);
+                delay_read(&c->sDelay, DL_MAIN, c->vInAnalyze, c->sDelay.nXOver, samples);
+                delay_read(&c->sDelay, DL_SC, c->vScBuffer, c->sDelay.nXOver, samples);
+                vAnalyze[c->nAnInChannel] = c->vInAnalyze;
+            }
 
-                // Surge protection
+            // Surge protection
+            {
+                const float * in[2];
+                for (size_t i=0; i<channels; ++i)
+                    in[i]           = vChannels[i].vIn;
+                sProtSC.process(vProtBuffer, in, samples);
+                sProt.process(vProtBuffer, vProtBuffer, samples);
+            }
+
+            // Start new frame of the flight recorder
+            rec_frame_t *rec    = &vRecFrames[nRecHead & (meta::gott_compressor::RECORDER_FRAMES - 1)];
+            rec->nSamples       = samples;
+            rec->fProt          = dsp::min(vProtBuffer, samples);
+
+            // MAIN PLUGIN STUFF
+            // The follower takes the VCA published by the leader of the group and does not run own
+            // detection. When the leader is lost, the follower holds the last leader's VCA while own
+            // detection warms up, and then cross-fades to own VCA
+            const bool follow   = vca_bus_read(samples);
+            const bool lead     = (bVcaLeader) && (pVcaBus != NULL);
+            const float xfade   = float(samples) / lsp_max(dspu::millis_to_samples(fSampleRate, meta::gott_compressor::VCA_XFADE_TIME), 1.0f);
+            if (follow)
+                nVcaHold            = dspu::millis_to_samples(fSampleRate, meta::gott_compressor::VCA_HOLD_TIME);
+            else
+                nVcaHold            = (nVcaHold > samples) ? nVcaHold - samples : 0;
+            const float mix0    = fVcaMix;
+            const float mix1    =
+                (follow) ? lsp_min(mix0 + xfade, 1.0f) :
+                (nVcaHold > 0) ? mix0 : lsp_max(mix0 - xfade, 0.0f);
+            fVcaMix             = mix1;
+            const bool detect   = (!follow) || (mix0 < 1.0f) || (mix1 < 1.0f);
+
+            for (size_t j=0; j<nBands; ++j)
+            {
+                // Prepare sidechain signal with band equalizers. Equalizers of all channels have
+                // the same settings and input, so equalizers of the first channel serve all channels
+                if (detect)
                 {
-                    const float * in[2];
-                    for (size_t i=0; i<channels; ++i)
-                        in[i]           = vChannels[i].vIn;
-                    sProtSC.process(vProtBuffer, in, to_process);
-                    sProt.process(vProtBuffer, vProtBuffer, to_process);
+                    band_t *sb          = &vChannels[0].vBands[j];
+                    sb->sEQ[0].process(vSC[0], vChannels[0].vScBuffer, samples);
+                    if (channels > 1)
+                        sb->sEQ[1].process(vSC[1], vChannels[1].vScBuffer, samples);
                 }
 
-                // MAIN PLUGIN STUFF
                 for (size_t i=0; i<channels; ++i)
                 {
-                    channel_t *c        = &vChannels[i];
+                    band_vca_t *v       = &vChannels[i].vVca[j];
+                    band_t *b           = &vChannels[i].vBands[j];
 
-                    for (size_t j=0; j<nBands; ++j)
+                    // Preprocess VCA signal
+                    if (detect)
                     {
-                        band_t *b           = &c->vBands[j];
-
-                        // Prepare sidechain signal with band equalizers
-                        b->sEQ[0].process(vSC[0], vChannels[0].vScBuffer, to_process);
-                        if (channels > 1)
-                            b->sEQ[1].process(vSC[1], vChannels[1].vScBuffer, to_process);
-
-                        // Preprocess VCA signal
-                        b->sSC.process(vBuffer, const_cast<const float **>(vSC), to_process);   // Band now contains processed by sidechain signal
-                        dsp::mul_k2(vBuffer, fScPreamp, to_process);
+                        b->sSC.process(vBuffer, const_cast<const float **>(vSC), samples);   // Band now contains processed by sidechain signal
+                        dsp::mul_k2(vBuffer, fScPreamp, samples);
+                    }
 
-                        if (b->bEnabled)
+                    if (v->bEnabled)
+                    {
+                        if (detect)
                         {
-                            b->sProc.process(b->vVCA, vEnv, vBuffer, to_process); // Output
+                            b->sProc.process(v->vVCA, vEnv, vBuffer, samples); // Output
 
                             // Output curve level
-                            float lvl = dsp::abs_max(vEnv, to_process);
-                            b->pEnvLvl->set_value(lvl);
-                            float vca = dsp::abs_max(b->vVCA, to_process) * b->fMakeup;
-                            b->pMeterGain->set_value(vca);
-                            lvl = b->sProc.curve(lvl) * b->fMakeup;
-                            b->pCurveLvl->set_value(lvl);
-
-                            // Remember last envelope level and buffer level
-                            b->fGainLevel   = b->vVCA[to_process-1] * b->fMakeup;
-
-                            // Check muting option
-                            if ((bProt) && (nScType == SCT_INTERNAL))
-                                dsp::fmmul_k3(b->vVCA, vProtBuffer, b->fMakeup, to_process);
-                            else
-                                dsp::mul_k2(b->vVCA, b->fMakeup, to_process); // Apply makeup gain
-
-                            // Patch the VCA signal
-                            if (b->bMute)
-                                dsp::fill(b->vVCA, GAIN_AMP_M_36_DB, to_process);
-                            else if (enXOver == XOVER_MODERN) // 'Modern' mode
-                                dsp::limit1(b->vVCA, GAIN_AMP_M_72_DB * b->fMakeup, GAIN_AMP_P_72_DB * b->fMakeup, to_process);
+                            float lvl = dsp::abs_max(vEnv, samples);
+                            b->pPorts->pEnvLvl->set_value(lvl);
+                            rec->vEnv[i][j]     = lvl;
+                            lvl = b->sProc.curve(lvl) * v->fMakeup;
+                            b->pPorts->pCurveLvl->set_value(lvl);
+
+                            // Apply the VCA of the leader
+                            if ((mix0 > 0.0f) || (mix1 > 0.0f))
+                            {
+                                dsp::lramp1(v->vVCA, 1.0f - mix0, 1.0f - mix1, samples);
+                                dsp::lramp_add2(v->vVCA, v->vLeader, mix0, mix1, samples);
+                            }
                         }
                         else
                         {
-                            dsp::fill(b->vVCA, (b->bMute) ? GAIN_AMP_M_36_DB : GAIN_AMP_0_DB, to_process);
-                            b->fGainLevel   = GAIN_AMP_0_DB;
+                            // Only the VCA of the leader is applied, own envelope is not known
+                            dsp::copy(v->vVCA, v->vLeader, samples);
+                            b->pPorts->pEnvLvl->set_value(0.0f);
+                            b->pPorts->pCurveLvl->set_value(0.0f);
+                            rec->vEnv[i][j]     = 0.0f;
                         }
-                    }
 
-                    // Output curve parameters for disabled bands
-                    for (size_t i=0; i<meta::gott_compressor::BANDS_MAX; ++i)
-                    {
-                        band_t *b      = &c->vBands[i];
-                        if (b->bEnabled)
-                            continue;
+                        // Publish the VCA for followers of the group
+                        if (lead)
+                            vca_bus_write(i, j, v->vVCA, samples);
+
+                        float vca = dsp::abs_max(v->vVCA, samples) * v->fMakeup;
+                        b->pPorts->pMeterGain->set_value(vca);
+
+                        // Remember last envelope level and buffer level
+                        v->fGainLevel   = v->vVCA[samples-1] * v->fMakeup;
+
+                        // Check muting option
+                        if ((bProt) && (SCT == SCT_INTERNAL))
+                            dsp::fmmul_k3(v->vVCA, vProtBuffer, v->fMakeup, samples);
+                        else
+                            dsp::mul_k2(v->vVCA, v->fMakeup, samples); // Apply makeup gain
 
-                        b->pEnvLvl->set_value(0.0f);
-                        b->pCurveLvl->set_value(0.0f);
-                        b->pMeterGain->set_value(GAIN_AMP_0_DB);
+                        // Patch the VCA signal
+                        if (v->bMute)
+                            dsp::fill(v->vVCA, GAIN_AMP_M_36_DB, samples);
+                        else if (XOVER == XOVER_MODERN) // 'Modern' mode
+                            dsp::limit1(v->vVCA, GAIN_AMP_M_72_DB * v->fMakeup, GAIN_AMP_P_72_DB * v->fMakeup, samples);
+
+                        dsp::minmax(v->vVCA, samples, &rec->vVCAMin[i][j], &rec->vVCAMax[i][j]);
+                    }
+                    else
+                    {
+                        if (lead)
+                            vca_bus_write(i, j, NULL, samples);
+                        dsp::fill(v->vVCA, (v->bMute) ? GAIN_AMP_M_36_DB : GAIN_AMP_0_DB, samples);
+                        v->fGainLevel   = GAIN_AMP_0_DB;
+
+                        rec->vEnv[i][j]     = 0.0f;
+                        rec->vVCAMin[i][j]  = v->vVCA[0];
+                        rec->vVCAMax[i][j]  = v->vVCA[0];
                     }
                 }
+            }
+            if (lead)
+                vca_bus_commit(samples);
+
+            // Output curve parameters for disabled bands
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
 
-                // Here, we apply VCA to input signal dependent on the input
-                if (enXOver == XOVER_MODERN) // 'Modern' mode
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                 {
-                    // Apply VCA control
-                    for (size_t i=0; i<channels; ++i)
+                    if (c->vVca[j].bEnabled)
+                        continue;
+
+                    band_t *b           = &c->vBands[j];
+                    b->pPorts->pEnvLvl->set_value(0.0f);
+                    b->pPorts->pCurveLvl->set_value(0.0f);
+                    b->pPorts->pMeterGain->set_value(GAIN_AMP_0_DB);
+
+                    if (j >= nBands)
                     {
-                        channel_t *c        = &vChannels[i];
+                        rec->vEnv[i][j]     = 0.0f;
+                        rec->vVCAMin[i][j]  = 0.0f;
+                        rec->vVCAMax[i][j]  = 0.0f;
+                    }
+                }
+            }
 
-                        // Apply delay to compensate lookahead feature
-                        c->sDelay.process(c->vInBuffer, c->vBuffer, to_process);
+            // Dry and wet chains with zero gain are not computed
+            const bool dry_on   = (fDryGain > GAIN_AMP_M_INF_DB) || (fOldDryGain > GAIN_AMP_M_INF_DB);
+            const bool wet_on   = (fWetGain > GAIN_AMP_M_INF_DB) || (fOldWetGain > GAIN_AMP_M_INF_DB);
+
+            // Filters and crossover of a re-enabled chain still contain stale data, so the
+            // chain is kept muted until the data is flushed and then faded in
+            const size_t settle = dspu::millis_to_samples(fSampleRate, meta::gott_compressor::BYPASS_WARM_UP_TIME);
+            if ((dry_on) && (!bDryOn) && (XOVER == XOVER_CLASSIC))
+                nDryHold            = settle;
+            if ((wet_on) && (!bWetOn))
+                nWetHold            = vChannels[0].sDelay.nXOver + settle;
+            bDryOn              = dry_on;
+            bWetOn              = wet_on;
+
+            const float dry_gain= (nDryHold > 0) ? GAIN_AMP_M_INF_DB : fDryGain;
+            const float wet_gain= (nWetHold > 0) ? GAIN_AMP_M_INF_DB : fWetGain;
+            nDryHold            = (nDryHold > samples) ? nDryHold - samples : 0;
+            nWetHold            = (nWetHold > samples) ? nWetHold - samples : 0;
+
+            // Here, we apply VCA to input signal dependent on the input
+            if (!wet_on) // Wet signal is not audible
+            {
+                // Only compensate latency of the dry signal
+                for (size_t i=0; i<channels; ++i)
+                {
+                    channel_t *c        = &vChannels[i];
 
-                        // Process first band
-                        band_t *b           = &c->vBands[0];
-                        sFilters.process(b->nFilterID, c->vBuffer, c->vInBuffer, b->vVCA, to_process);
+                    delay_read(&c->sDelay, DL_MAIN, c->vInBuffer, c->sDelay.nLookahead + c->sDelay.nXOver, samples);
+                    dsp::fill_zero(c->vBuffer, samples);
+                }
+            }
+            else if (XOVER == XOVER_MODERN) // 'Modern' mode
+            {
+                // Apply VCA control
+                for (size_t i=0; i<channels; ++i)
+                {
+                    channel_t *c        = &vChannels[i];
 
-                        // Process other bands
-                        for (size_t j=1; j<nBands; ++j)
-                        {
-                            b                   = &c->vBands[j];
-                            sFilters.process(b->nFilterID, c->vBuffer, c->vBuffer, b->vVCA, to_process);
-                        }
+                    // Apply delay to compensate lookahead feature
+                    delay_read(&c->sDelay, DL_MAIN, c->vInBuffer, c->sDelay.nLookahead, samples);
+
+                    // Process first band
+                    band_vca_t *v       = &c->vVca[0];
+                    sFilters.process(v->nFilterID, c->vBuffer, c->vInBuffer, v->vVCA, samples);
+
+                    // Process other bands
+                    for (size_t j=1; j<nBands; ++j)
+                    {
+                        v                   = &c->vVca[j];
+                        sFilters.process(v->nFilterID, c->vBuffer, c->vBuffer, v->vVCA, samples);
                     }
                 }
-                else if (enXOver == XOVER_CLASSIC) // 'Classic' mode
+            }
+            else if (XOVER == XOVER_CLASSIC) // 'Classic' mode
+            {
+                // Each channel runs its own filters: dspu::Filter keeps private single-lane state,
+                // there is no packed L/R filter engine
+                // Apply VCA control
+                for (size_t i=0; i<channels; ++i)
                 {
-                    // Apply VCA control
-                    for (size_t i=0; i<channels; ++i)
-                    {
-                        channel_t *c        = &vChannels[i];
+                    channel_t *c        = &vChannels[i];
 
-                        // Originally, there is no signal
-                        c->sDelay.process(c->vInBuffer, c->vBuffer, to_process); // Apply delay to compensate lookahead feature, store into vBuffer
+                    // Originally, there is no signal
+                    delay_read(&c->sDelay, DL_MAIN, c->vInBuffer, c->sDelay.nLookahead, samples); // Apply delay to compensate lookahead feature, store into vInBuffer
 
-                        // First band
-                        band_t *b       = &c->vBands[0];
-                        // Filter frequencies from input
-                        b->sPassFilter.process(vEnv, c->vInBuffer, to_process);
-                        // Apply VCA gain and add to the channel buffer
-                        dsp::mul3(c->vBuffer, vEnv, b->vVCA, to_process);
-                        // Filter frequencies from input
-                        b->sRejFilter.process(vBuffer, c->vInBuffer, to_process);
+                    // First band
+                    band_t *b       = &c->vBands[0];
+                    // Filter frequencies from input
+                    b->sPassFilter.process(vEnv, c->vInBuffer, samples);
+                    // Apply VCA gain and add to the channel buffer
+                    dsp::mul3(c->vBuffer, vEnv, c->vVca[0].vVCA, samples);
+                    // Filter frequencies from input
+                    b->sRejFilter.process(vBuffer, c->vInBuffer, samples);
 
-                        // Other bands
-                        for (size_t j=1; j<nBands; ++j)
-                        {
-                            b               = &c->vBands[j];
-
-                            // Process the signal with all-pass
-                            b->sAllFilter.process(c->vBuffer, c->vBuffer, to_process);
-                            // Filter frequencies from input
-                            b->sPassFilter.process(vEnv, vBuffer, to_process);
-                            // Apply VCA gain and add to the channel buffer
-                            dsp::fmadd3(c->vBuffer, vEnv, b->vVCA, to_process);
-                            // Filter frequencies from input
-                            b->sRejFilter.process(vBuffer, vBuffer, to_process);
-                        }
+                    // Other bands
+                    for (size_t j=1; j<nBands; ++j)
+                    {
+                        b               = &c->vBands[j];
+
+                        // Process the signal with all-pass
+                        b->sAllFilter.process(c->vBuffer, c->vBuffer, samples);
+                        // Filter frequencies from input
+                        b->sPassFilter.process(vEnv, vBuffer, samples);
+                        // Apply VCA gain and add to the channel buffer
+                        dsp::fmadd3(c->vBuffer, vEnv, c->vVca[j].vVCA, samples);
+                        // Filter frequencies from input
+                        b->sRejFilter.process(vBuffer, vBuffer, samples);
                     }
                 }
-                else // enXOver == XOVER_LINEAR_PHASE
+            }
+            else // XOVER == XOVER_LINEAR_PHASE
+            {
+                // Apply VCA control
+                for (size_t i=0; i<channels; ++i)
                 {
-                    // Apply VCA control
-                    for (size_t i=0; i<channels; ++i)
-                    {
-                        channel_t *c        = &vChannels[i];
+                    channel_t *c        = &vChannels[i];
 
-                        // Apply delay to compensate lookahead feature
-                        c->sDelay.process(c->vBuffer, c->vBuffer, to_process);
-                        // Apply delay to unprocessed signal to compensate lookahead + crossover delay
-                        c->sXOverDelay.process(c->vInBuffer, c->vBuffer, to_process);
-                        c->sFFTXOver.process(c->vBuffer, to_process);
+                    // Apply delay to compensate lookahead feature
+                    delay_read(&c->sDelay, DL_MAIN, c->vBuffer, c->sDelay.nLookahead, samples);
+                    // Apply delay to unprocessed signal to compensate lookahead + crossover delay
+                    delay_read(&c->sDelay, DL_MAIN, c->vInBuffer, c->sDelay.nLookahead + c->sDelay.nXOver, samples);
+                    c->pFFTXOver->process(c->vBuffer, samples);
 
-                        // First band
-                        band_t *b           = &c->vBands[0];
-                        dsp::mul3(c->vBuffer, b->vVCA, b->vBuffer, to_process);
+                    // First band
+                    band_vca_t *v       = &c->vVca[0];
+                    dsp::mul3(c->vBuffer, v->vVCA, v->vBuffer, samples);
 
-                        // Other bands
-                        for (size_t j=1; j<nBands; ++j)
-                        {
-                            b                   = &c->vBands[j];
-                            dsp::fmadd3(c->vBuffer, b->vVCA, b->vBuffer, to_process);
-                        }
+                    // Other bands
+                    for (size_t j=1; j<nBands; ++j)
+                    {
+                        v                   = &c->vVca[j];
+                        dsp::fmadd3(c->vBuffer, v->vVCA, v->vBuffer, samples);
                     }
                 }
+            }
 
-                // MAIN PLUGIN STUFF END
+            // MAIN PLUGIN STUFF END
 
-                // Do output channel analysis
-                for (size_t i=0; i<channels; ++i)
+            // Do output channel analysis
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                vAnalyze[c->nAnOutChannel]  = c->vBuffer;
+            }
+
+            if ((bAnalyzer) && (sAnalyzer.activity()))
+                sAnalyzer.process(vAnalyze, samples);
+
+            // Post-process data, apply dry/wet balance, bypass and do final metering
+            process_output(samples, dry_gain, wet_gain);
+
+            // Update gain reduction history, bands that are not in use have unit gain
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                 {
-                    channel_t *c        = &vChannels[i];
-                    vAnalyze[c->nAnOutChannel]  = c->vBuffer;
+                    band_t *b           = &c->vBands[j];
+                    history_push(b->vHistory, (j < nBands) ? c->vVca[j].vVCA : NULL, samples);
                 }
+            }
+
+            // Commit the frame of the flight recorder
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                rec->vIn[i]         = c->pInLvl->value();
+                rec->vOut[i]        = c->pOutLvl->value();
+            }
+            atomic_store(&nRecHead, uint32_t(nRecHead + 1));
 
-                if (sAnalyzer.activity())
-                    sAnalyzer.process(vAnalyze, to_process);
+            // Commit the dry/wet gain
+            fOldDryGain         = dry_gain;
+            fOldWetGain         = wet_gain;
+        }
 
-                // Post-process data (if needed)
-                if (nMode == GOTT_MS)
+        gott_compressor::process_block_t gott_compressor::select_process_block(uint32_t xover, uint32_t sct)
+        {
+            static const process_block_t list[3][3] =
+            {
+                {
+                    &gott_compressor::process_block<XOVER_CLASSIC, SCT_INTERNAL>,
+                    &gott_compressor::process_block<XOVER_CLASSIC, SCT_EXTERNAL>,
+                    &gott_compressor::process_block<XOVER_CLASSIC, SCT_LINK>
+                },
                 {
-                    dsp::ms_to_lr(vChannels[0].vBuffer, vChannels[1].vBuffer, vChannels[0].vBuffer, vChannels[1].vBuffer, to_process);
-                    dsp::ms_to_lr(vChannels[0].vInBuffer, vChannels[1].vInBuffer, vChannels[0].vInBuffer, vChannels[1].vInBuffer, to_process);
+                    &gott_compressor::process_block<XOVER_MODERN, SCT_INTERNAL>,
+                    &gott_compressor::process_block<XOVER_MODERN, SCT_EXTERNAL>,
+                    &gott_compressor::process_block<XOVER_MODERN, SCT_LINK>
+                },
+                {
+                    &gott_compressor::process_block<XOVER_LINEAR_PHASE, SCT_INTERNAL>,
+                    &gott_compressor::process_block<XOVER_LINEAR_PHASE, SCT_EXTERNAL>,
+                    &gott_compressor::process_block<XOVER_LINEAR_PHASE, SCT_LINK>
                 }
+            };
 
-                // Final metering
-                for (size_t i=0; i<channels; ++i)
-                {
-                    channel_t *c        = &vChannels[i];
+            return list[lsp_min(xover, 2u)][lsp_min(sct, 2u)];
+        }
 
-                    // Apply dry/wet balance
-                    if (enXOver == XOVER_MODERN)
-                        dsp::mix2(c->vBuffer, c->vInBuffer, fWetGain, fDryGain, to_process);
-                    else if (enXOver == XOVER_CLASSIC)
-                    {
-                        c->sDryEq.process(vBuffer, c->vInBuffer, to_process);
-                        dsp::mix2(c->vBuffer, vBuffer, fWetGain, fDryGain, to_process);
-                    }
-                    else // enXOver == XOVER_LINEAR_PHASE
-                        dsp::mix2(c->vBuffer, c->vInBuffer, fWetGain, fDryGain, to_process);
+        void gott_compressor::process(size_t samples)
+        {
+            const size_t channels     = (nMode == GOTT_MONO) ? 1 : 2;
+
+            // Mark the real-time section to trap non-RT-safe calls
+            ++nRtDepth;
+            lsp_finally { --nRtDepth; };
+
+            // Measure DSP time for the statistics segment
+            system::time_t start;
+            if (pStats != NULL)
+                system::get_time(&start);
+
+            // Handle allocation of linear phase state, analyzer and detector sharing bus
+            sync_xover_state();
+            sync_analyzer();
+            sync_vca_bus();
+
+            // Bind input signal
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                sPremix.vIn[i]      = c->pIn->buffer<float>();
+                sPremix.vOut[i]     = c->pOut->buffer<float>();
+                sPremix.vSc[i]      = (c->pScIn != NULL) ? c->pScIn->buffer<float>() : sPremix.vIn[i];
+                sPremix.vLink[i]    = NULL;
+
+                core::AudioBuffer *shm_buf  = (c->pShmIn != NULL) ? c->pShmIn->buffer<core::AudioBuffer>() : NULL;
+                if ((shm_buf != NULL) && (shm_buf->active()))
+                    sPremix.vLink[i]    = shm_buf->buffer();
+            }
+
+            // Follow the host buffer size to process it in as few passes as possible
+            sync_block_state(samples);
+
+            // Split the host buffer into blocks of nearly equal size to avoid short tail blocks
+            const size_t blocks     = (samples + nBlockSize - 1) / nBlockSize;
+            const size_t block_size = (blocks > 1) ?
+                lsp_min(align_size((samples + blocks - 1) / blocks, 0x10), nBlockSize) :
+                nBlockSize;
 
-                    // Compute output level
-                    float level         = dsp::abs_max(c->vBuffer, to_process);
-                    c->pOutLvl->set_value(level);
+            // Do processing
+            for (size_t offset = 0; offset < samples;)
+            {
+                // Determine buffer size for processing
+                size_t to_process   = lsp_min(block_size, samples-offset);
 
-                    // Apply bypass
-                    c->sDryDelay.process(vBuffer, c->vIn, to_process);
-                    c->sBypass.process(c->vOut, vBuffer, c->vBuffer, to_process);
+                // Process pre-mix
+                process_premix(to_process);
+
+                // Pass the dry signal only if processing is suspended
+                if (nBypassState == BYP_SUSPENDED)
+                {
+                    process_suspended(to_process);
+                    offset     += to_process;
+                    continue;
                 }
+
+                // Process audio block
+                (this->*pProcessBlock)(to_process);
+
+                // Update bypass state
+                update_bypass_state(to_process);
                 offset     += to_process;
             }
 
             sCounter.submit(samples);
 
+            // Publish statistics
+            if (pStats != NULL)
+                publish_stats(samples, &start);
+
             // Synchronize meshes with the UI
             plug::mesh_t *mesh = NULL;
 
@@ -1679,22 +4021,42 @@ namespace lsp
             {
                 channel_t *c        = &vChannels[i];
 
-                // Calculate transfer function for the compressor
-                if (sCounter.fired())
+                // The transfer function is consumed by the amplitude graph and the inline display
+                mesh                = (c->pAmpGraph != NULL) ? c->pAmpGraph->buffer<plug::mesh_t>() : NULL;
+                const bool amp_free = (mesh != NULL) && (mesh->isEmpty());
+
+                // Check that band curves or gain levels have changed since the last computation
+                bool amp_update     = false;
+                for (size_t j=0; j<nBands; ++j)
+                {
+                    const band_t *b     = &c->vBands[j];
+                    if ((b->nSync & S_BAND_CURVE) || (c->vAmpGain[j] != c->vVca[j].fGainLevel))
+                    {
+                        amp_update          = true;
+                        break;
+                    }
+                }
+
+                // Calculate transfer function for the compressor only if there is a consumer for it
+                if ((sCounter.fired()) && (amp_update) && ((amp_free) || (pIDisplay != NULL)))
                 {
                     if (enXOver == XOVER_MODERN)
                     {
                         // Calculate transfer function
-                        band_t *b       = &c->vBands[0];
-                        sFilters.freq_chart(b->nFilterID, c->vTmpFilterBuffer, vFreqBuffer, b->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
+                        const band_vca_t *v = &c->vVca[0];
+                        sFilters.freq_chart(v->nFilterID, vTmpFilter, vFreqBuffer, v->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
 
                         for (size_t j=1; j<nBands; ++j)
                         {
-                            b               = &c->vBands[j];
-                            sFilters.freq_chart(b->nFilterID, vTr, vFreqBuffer, b->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
-                            dsp::pcomplex_mul2(c->vTmpFilterBuffer, vTr, meta::gott_compressor::FFT_MESH_POINTS);
+                            v               = &c->vVca[j];
+                            sFilters.freq_chart(v->nFilterID, vTr, vFreqBuffer, v->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
+                            dsp::pcomplex_mul2(vTmpFilter, vTr, meta::gott_compressor::FFT_MESH_POINTS);
                         }
-                        dsp::pcomplex_mod(c->vFilterBuffer, c->vTmpFilterBuffer, meta::gott_compressor::FFT_MESH_POINTS);
+                        dsp::pcomplex_mod(c->vFilterBuffer, vTmpFilter, meta::gott_compressor::FFT_MESH_POINTS);
+
+                        // Band curves are not used in 'modern' mode
+                        for (size_t j=0; j<nBands; ++j)
+                            c->vBands[j].nSync &= ~size_t(S_BAND_CURVE);
                     }
                     else if (enXOver == XOVER_CLASSIC)
                     {
@@ -1703,7 +4065,7 @@ namespace lsp
 
                         // Apply lo-pass filter characteristics
                         b->sPassFilter.freq_chart(vTr, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
-                        dsp::mul_k3(c->vTmpFilterBuffer, vTr, b->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS*2);
+                        dsp::mul_k3(vTmpFilter, vTr, c->vVca[0].fGainLevel, meta::gott_compressor::FFT_MESH_POINTS*2);
 
                         // Apply hi-pass filter characteristics
                         b->sRejFilter.freq_chart(vRFc, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
@@ -1716,18 +4078,18 @@ namespace lsp
 
                             // Apply all-pass characteristics
                             b->sAllFilter.freq_chart(vPFc, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
-                            dsp::pcomplex_mul2(c->vTmpFilterBuffer, vPFc, meta::gott_compressor::FFT_MESH_POINTS);
+                            dsp::pcomplex_mul2(vTmpFilter, vPFc, meta::gott_compressor::FFT_MESH_POINTS);
 
                             // Apply lo-pass filter characteristics
                             b->sPassFilter.freq_chart(vPFc, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
                             dsp::pcomplex_mul2(vPFc, vTr, meta::gott_compressor::FFT_MESH_POINTS);
-                            dsp::fmadd_k3(c->vTmpFilterBuffer, vPFc, b->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS*2);
+                            dsp::fmadd_k3(vTmpFilter, vPFc, c->vVca[j].fGainLevel, meta::gott_compressor::FFT_MESH_POINTS*2);
 
                             // Apply hi-pass filter characteristics
                             b->sRejFilter.freq_chart(vRFc, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
                             dsp::pcomplex_mul2(vTr, vRFc, meta::gott_compressor::FFT_MESH_POINTS);
                         }
-                        dsp::pcomplex_mod(c->vFilterBuffer, c->vTmpFilterBuffer, meta::gott_compressor::FFT_MESH_POINTS);
+                        dsp::pcomplex_mod(c->vFilterBuffer, vTmpFilter, meta::gott_compressor::FFT_MESH_POINTS);
 
                         // Calculate transfer function
                         for (size_t j=0; j<nBands; ++j)
@@ -1750,11 +4112,11 @@ namespace lsp
                                 b->nSync           &= ~size_t(S_BAND_CURVE);
                             }
                             if (j == 0)
-                                dsp::mul_k3(c->vTmpFilterBuffer, b->vFilterBuffer, b->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
+                                dsp::mul_k3(vTmpFilter, b->vFilterBuffer, c->vVca[j].fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
                             else
-                                dsp::fmadd_k3(c->vTmpFilterBuffer, b->vFilterBuffer, b->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
+                                dsp::fmadd_k3(vTmpFilter, b->vFilterBuffer, c->vVca[j].fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
                         }
-                        dsp::copy(c->vFilterBuffer, c->vTmpFilterBuffer, meta::gott_compressor::FFT_MESH_POINTS);
+                        dsp::copy(c->vFilterBuffer, vTmpFilter, meta::gott_compressor::FFT_MESH_POINTS);
                     }
                     else // enXOver == XOVER_LINEAR_PHASE
                     {
@@ -1765,35 +4127,67 @@ namespace lsp
                             size_t band         = b - c->vBands;
                             if (b->nSync & S_BAND_CURVE)
                             {
-                                c->sFFTXOver.freq_chart(band, b->vFilterBuffer, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
+                                c->pFFTXOver->freq_chart(band, b->vFilterBuffer, vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
                                 b->nSync           &= ~size_t(S_BAND_CURVE);
                             }
                             if (j == 0)
-                                dsp::mul_k3(c->vTmpFilterBuffer, b->vFilterBuffer, b->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
+                                dsp::mul_k3(vTmpFilter, b->vFilterBuffer, c->vVca[j].fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
                             else
-                                dsp::fmadd_k3(c->vTmpFilterBuffer, b->vFilterBuffer, b->fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
+                                dsp::fmadd_k3(vTmpFilter, b->vFilterBuffer, c->vVca[j].fGainLevel, meta::gott_compressor::FFT_MESH_POINTS);
                         }
 
                         // Copy the result to the output buffer
-                        dsp::copy(c->vFilterBuffer, c->vTmpFilterBuffer, meta::gott_compressor::FFT_MESH_POINTS);
+                        dsp::copy(c->vFilterBuffer, vTmpFilter, meta::gott_compressor::FFT_MESH_POINTS);
                     }
+
+                    // Remember the inputs of the computed transfer function
+                    for (size_t j=0; j<nBands; ++j)
+                        c->vAmpGain[j]      = c->vVca[j].fGainLevel;
+                    c->bAmpSync         = true;
+                    bIDisplaySync       = true;
                 }
 
-                // Output Channel curve
-                mesh            = (c->pAmpGraph != NULL) ? c->pAmpGraph->buffer<plug::mesh_t>() : NULL;
-                if ((mesh != NULL) && (mesh->isEmpty()))
+                // Output Channel curve only if it has changed
+                if ((amp_free) && (c->bAmpSync))
                 {
                     // Calculate amplitude (modulo)
                     dsp::copy(mesh->pvData[0], vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
                     dsp::copy(mesh->pvData[1], c->vFilterBuffer, meta::gott_compressor::FFT_MESH_POINTS);
                     mesh->data(2, meta::gott_compressor::FFT_MESH_POINTS);
+                    c->bAmpSync         = false;
+                }
+
+                // Output gain reduction history only when the previous frame has been consumed
+                mesh            = (c->pGrHistory != NULL) ? c->pGrHistory->buffer<plug::mesh_t>() : NULL;
+                if ((mesh != NULL) && (mesh->isEmpty()))
+                {
+                    constexpr size_t points = meta::gott_compressor::GR_HISTORY_POINTS;
+                    const size_t window     = lsp_max(dspu::seconds_to_samples(fSampleRate, fGrTime), size_t(1));
+
+                    // Select the finest level which covers the whole window
+                    size_t level            = 0;
+                    while ((level + 1 < meta::gott_compressor::GR_HISTORY_LEVELS) &&
+                           ((points * meta::gott_compressor::GR_HISTORY_DECIM << level) < window))
+                        ++level;
+                    const size_t cell       = meta::gott_compressor::GR_HISTORY_DECIM << level;
+                    const size_t cells      = lsp_limit((window + cell - 1) / cell, size_t(1), points);
+                    const float duration    = (fSampleRate > 0) ? float(cells * cell) / fSampleRate : 0.0f;
+
+                    // Time axis is in seconds relative to the current moment
+                    for (size_t k=0; k<points; ++k)
+                        mesh->pvData[0][k]      = (float(k) / (points - 1) - 1.0f) * duration;
+
+                    for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                        history_fetch(c->vBands[j].vHistory, mesh->pvData[j*2 + 1], mesh->pvData[j*2 + 2], level, cells, points);
+
+                    mesh->data(1 + meta::gott_compressor::BANDS_MAX * 2, points);
                 }
 
                 // Output FFT curve for input
                 mesh            = (c->pFftIn != NULL) ? c->pFftIn->buffer<plug::mesh_t>() : NULL;
                 if ((mesh != NULL) && (mesh->isEmpty()))
                 {
-                    if (c->bInFft)
+                    if ((bAnalyzer) && (c->bInFft))
                     {
                         // Add extra points
                         mesh->pvData[0][0] = SPEC_FREQ_MIN * 0.5f;
@@ -1816,7 +4210,7 @@ namespace lsp
                 mesh            = (c->pFftOut != NULL) ? c->pFftOut->buffer<plug::mesh_t>() : NULL;
                 if ((mesh != NULL) && (mesh->isEmpty()))
                 {
-                    if (sAnalyzer.channel_active(c->nAnOutChannel))
+                    if ((bAnalyzer) && (sAnalyzer.channel_active(c->nAnOutChannel)))
                     {
                         // Copy frequency points
                         dsp::copy(mesh->pvData[0], vFreqBuffer, meta::gott_compressor::FFT_MESH_POINTS);
@@ -1832,12 +4226,13 @@ namespace lsp
                 // Output band curves
                 for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
                 {
+                    const band_vca_t *v = &c->vVca[j];
                     band_t *b           = &c->vBands[j];
 
                     // Compressor band curve
                     if (b->nSync & S_EQ_CURVE)
                     {
-                        mesh                = (b->pFreqMesh!= NULL) ? b->pFreqMesh->buffer<plug::mesh_t>() : NULL;
+                        mesh                = (b->pPorts->pFreqMesh!= NULL) ? b->pPorts->pFreqMesh->buffer<plug::mesh_t>() : NULL;
                         if ((mesh != NULL) && (mesh->isEmpty()))
                         {
                             // Add extra points
@@ -1859,16 +4254,16 @@ namespace lsp
                     // Compressor function curve
                     if (b->nSync & S_COMP_CURVE)
                     {
-                        mesh                = (b->pCurveMesh != NULL) ? b->pCurveMesh->buffer<plug::mesh_t>() : NULL;
+                        mesh                = (b->pPorts->pCurveMesh != NULL) ? b->pPorts->pCurveMesh->buffer<plug::mesh_t>() : NULL;
                         if ((mesh != NULL) && (mesh->isEmpty()))
                         {
-                            if (b->bEnabled)
+                            if (v->bEnabled)
                             {
                                 // Copy frequency points
                                 dsp::copy(mesh->pvData[0], vCurveBuffer, meta::gott_compressor::CURVE_MESH_SIZE);
                                 b->sProc.curve(mesh->pvData[1], vCurveBuffer, meta::gott_compressor::CURVE_MESH_SIZE);
-                                if (b->fMakeup != GAIN_AMP_0_DB)
-                                    dsp::mul_k2(mesh->pvData[1], b->fMakeup, meta::gott_compressor::CURVE_MESH_SIZE);
+                                if (v->fMakeup != GAIN_AMP_0_DB)
+                                    dsp::mul_k2(mesh->pvData[1], v->fMakeup, meta::gott_compressor::CURVE_MESH_SIZE);
 
                                 // Mark mesh containing data
                                 mesh->data(2, meta::gott_compressor::CURVE_MESH_SIZE);
@@ -1883,9 +4278,22 @@ namespace lsp
                 }
             }
 
-            // Request for redraw
-            if ((pWrapper != NULL) && (sCounter.fired()))
+            // Request for redraw only if the displayed data has changed
+            const bool bypassing    = vChannels[0].sBypass.bypassing();
+            if (bypassing != bIDisplayBypass)
+            {
+                bIDisplayBypass         = bypassing;
+                bIDisplaySync           = true;
+            }
+            if ((pWrapper != NULL) && (sCounter.fired()) && (bIDisplaySync))
+            {
                 pWrapper->query_display_draw();
+                bIDisplaySync           = false;
+            }
+
+            // Adapt the refresh rate to the activity of the displayed data
+            if (sCounter.fired())
+                update_refresh_rate();
 
             sCounter.commit();
         }
@@ -1902,6 +4310,22 @@ namespace lsp
             width   = cv->width();
             height  = cv->height();
 
+            // Allocate buffer: x, y, tr, index, weight
+            core::IDBuffer *old = pIDisplay;
+            pIDisplay           = core::IDBuffer::reuse(pIDisplay, 5, width+2);
+            core::IDBuffer *b   = pIDisplay;
+            if (b == NULL)
+            {
+                sIDisplay.nWidth    = 0;
+                return false;
+            }
+
+            // Update the cached layout only when geometry or zoom has changed
+            if ((b != old) || (sIDisplay.vFreqs != vFreqBuffer) || (sIDisplay.nWidth != width))
+                update_idisplay_mapping(width);
+            if ((sIDisplay.nHeight != height) || (sIDisplay.fZoom != fZoom))
+                update_idisplay_grid(height);
+
             // Clear background
             bool bypassing = vChannels[0].sBypass.bypassing();
             cv->set_color_rgb((bypassing) ? CV_DISABLED : CV_BACKGROUND);
@@ -1910,43 +4334,15 @@ namespace lsp
             // Draw axis
             cv->set_line_width(1.0);
 
-            // "-72 db / (:zoom ** 3)" max="24 db * :zoom"
-
-            float miny  = logf(GAIN_AMP_M_72_DB / dsp::ipowf(fZoom, 3));
-            float maxy  = logf(GAIN_AMP_P_24_DB * fZoom);
-
-            float zx    = 1.0f/SPEC_FREQ_MIN;
-            float zy    = dsp::ipowf(fZoom, 3)/GAIN_AMP_M_72_DB;
-            float dx    = width/(logf(SPEC_FREQ_MAX)-logf(SPEC_FREQ_MIN));
-            float dy    = height/(miny-maxy);
-
             // Draw vertical lines
             cv->set_color_rgb(CV_YELLOW, 0.5f);
-            for (float i=100.0f; i<SPEC_FREQ_MAX; i *= 10.0f)
-            {
-                float ax = dx*(logf(i*zx));
-                cv->line(ax, 0, ax, height);
-            }
+            for (size_t i=0; i<sIDisplay.nGridX; ++i)
+                cv->line(sIDisplay.vGridX[i], 0, sIDisplay.vGridX[i], height);
 
             // Draw horizontal lines
             cv->set_color_rgb(CV_WHITE, 0.5f);
-            for (float i=GAIN_AMP_M_72_DB; i<GAIN_AMP_P_24_DB; i *= GAIN_AMP_P_12_DB)
-            {
-                float ay = height + dy*(logf(i*zy));
-                cv->line(0, ay, width, ay);
-            }
-
-            // Allocate buffer: f, x, y, tr
-            pIDisplay           = core::IDBuffer::reuse(pIDisplay, 4, width+2);
-            core::IDBuffer *b   = pIDisplay;
-            if (b == NULL)
-                return false;
-
-            // Initialize mesh
-            b->v[0][0]          = SPEC_FREQ_MIN*0.5f;
-            b->v[0][width+1]    = SPEC_FREQ_MAX*2.0f;
-            b->v[3][0]          = 1.0f;
-            b->v[3][width+1]    = 1.0f;
+            for (size_t i=0; i<sIDisplay.nGridY; ++i)
+                cv->line(0, sIDisplay.vGridY[i], width, sIDisplay.vGridY[i]);
 
             static const uint32_t c_colors[] = {
                 CV_MIDDLE_CHANNEL,
@@ -1965,29 +4361,384 @@ namespace lsp
 
             for (size_t i=0; i<channels; ++i)
             {
-                channel_t *c    = &vChannels[i];
+                const float *tr = vChannels[i].vFilterBuffer;
+                const float *vi = b->v[3];
+                const float *vw = b->v[4];
 
-                for (size_t j=0; j<width; ++j)
+                // Interpolate the transfer function using the cached mapping
+                for (size_t j=1; j<=width; ++j)
                 {
-                    size_t k        = (j*meta::gott_compressor::FFT_MESH_POINTS)/width;
-                    b->v[0][j+1]    = vFreqBuffer[k];
-                    b->v[3][j+1]    = c->vFilterBuffer[k];
+                    const size_t k  = size_t(vi[j]);
+                    b->v[2][j]      = tr[k] + (tr[k+1] - tr[k]) * vw[j];
                 }
 
-                dsp::fill(b->v[1], 0.0f, width+2);
-                dsp::fill(b->v[2], height, width+2);
-                dsp::axis_apply_log1(b->v[1], b->v[0], zx, dx, width+2);
-                dsp::axis_apply_log1(b->v[2], b->v[3], zy, dy, width+2);
+                dsp::fill(b->v[1], height, width+2);
+                dsp::axis_apply_log1(b->v[1], b->v[2], sIDisplay.fZy, sIDisplay.fDy, width+2);
 
                 // Draw mesh
                 uint32_t color = (bypassing || !(active())) ? CV_SILVER : vc[i];
                 Color stroke(color), fill(color, 0.5f);
-                cv->draw_poly(b->v[1], b->v[2], width+2, stroke, fill);
+                cv->draw_poly(b->v[0], b->v[1], width+2, stroke, fill);
             }
 
             return true;
         }
 
+        void gott_compressor::update_idisplay_mapping(size_t width)
+        {
+            constexpr size_t points = meta::gott_compressor::FFT_MESH_POINTS;
+            core::IDBuffer *b       = pIDisplay;
+            float *vf               = b->v[2];
+            float *vi               = b->v[3];
+            float *vw               = b->v[4];
+            const float step        = (width > 1) ? float(points - 1) / float(width - 1) : 0.0f;
+
+            // Compute index and weight of the grid point for each pixel
+            vf[0]                   = SPEC_FREQ_MIN*0.5f;
+            vf[width+1]             = SPEC_FREQ_MAX*2.0f;
+            for (size_t j=0; j<width; ++j)
+            {
+                const float pos         = j * step;
+                const size_t k          = lsp_min(size_t(pos), points - 2);
+                const float w           = pos - k;
+                vi[j+1]                 = float(k);
+                vw[j+1]                 = w;
+                vf[j+1]                 = vFreqBuffer[k] + (vFreqBuffer[k+1] - vFreqBuffer[k]) * w;
+            }
+
+            // The horizontal coordinates do not depend on the transfer function
+            const float zx          = 1.0f/SPEC_FREQ_MIN;
+            const float dx          = width/(logf(SPEC_FREQ_MAX)-logf(SPEC_FREQ_MIN));
+            dsp::fill(b->v[0], 0.0f, width+2);
+            dsp::axis_apply_log1(b->v[0], vf, zx, dx, width+2);
+
+            // Margin points of the transfer function
+            b->v[2][0]              = 1.0f;
+            b->v[2][width+1]        = 1.0f;
+
+            // Positions of vertical lines
+            sIDisplay.nGridX        = 0;
+            for (float i=100.0f; i<SPEC_FREQ_MAX; i *= 10.0f)
+                sIDisplay.vGridX[sIDisplay.nGridX++]    = dx*(logf(i*zx));
+
+            sIDisplay.vFreqs        = vFreqBuffer;
+            sIDisplay.nWidth        = width;
+        }
+
+        void gott_compressor::update_idisplay_grid(size_t height)
+        {
+            // "-72 db / (:zoom ** 3)" max="24 db * :zoom"
+            const float miny        = logf(GAIN_AMP_M_72_DB / dsp::ipowf(fZoom, 3));
+            const float maxy        = logf(GAIN_AMP_P_24_DB * fZoom);
+            const float zy          = dsp::ipowf(fZoom, 3)/GAIN_AMP_M_72_DB;
+            const float dy          = height/(miny-maxy);
+
+            // Positions of horizontal lines
+            sIDisplay.nGridY        = 0;
+            for (float i=GAIN_AMP_M_72_DB; i<GAIN_AMP_P_24_DB; i *= GAIN_AMP_P_12_DB)
+                sIDisplay.vGridY[sIDisplay.nGridY++]    = height + dy*(logf(i*zy));
+
+            sIDisplay.fZy           = zy;
+            sIDisplay.fDy           = dy;
+            sIDisplay.nHeight       = height;
+            sIDisplay.fZoom         = fZoom;
+        }
+
+        size_t gott_compressor::snapshot_size() const
+        {
+            if (vChannels == NULL)
+                return 0;
+
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            size_t size             = sizeof(snapshot_header_t);
+            for (size_t i=0; i<channels; ++i)
+            {
+                const delay_line_t *dl  = &vChannels[i].sDelay;
+                size                   += sizeof(snapshot_channel_t);
+                for (size_t j=0; j<DL_TOTAL; ++j)
+                    size                   += dl->vSize[j] * sizeof(float);
+            }
+
+            return size;
+        }
+
+        size_t gott_compressor::save_snapshot(void *dst, size_t size) const
+        {
+            const size_t total      = snapshot_size();
+            if ((total <= 0) || (dst == NULL) || (size < total))
+                return 0;
+
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            uint8_t *ptr            = static_cast<uint8_t *>(dst);
+
+            // Write header
+            snapshot_header_t hdr;
+            hdr.nMagic              = SNAPSHOT_MAGIC;
+            hdr.nVersion            = SNAPSHOT_VERSION;
+            hdr.nSize               = uint32_t(total);
+            hdr.nSampleRate         = uint32_t(fSampleRate);
+            hdr.nMode               = uint32_t(nMode);
+            hdr.nXOver              = uint32_t(enXOver);
+            hdr.nChannels           = uint32_t(channels);
+            hdr.nBands              = uint32_t(nBands);
+            hdr.nBypassState        = nBypassState;
+            hdr.nBypassCounter      = nBypassCounter;
+            hdr.fOldDryGain         = fOldDryGain;
+            hdr.fOldWetGain         = fOldWetGain;
+            memcpy(ptr, &hdr, sizeof(hdr));
+            ptr                    += sizeof(hdr);
+
+            // The envelope levels are taken from the last frame of the flight recorder
+            const uint32_t head     = atomic_load(&nRecHead);
+            const rec_frame_t *rec  = (head > 0) ? &vRecFrames[(head - 1) & (meta::gott_compressor::RECORDER_FRAMES - 1)] : NULL;
+
+            // Write channel records
+            for (size_t i=0; i<channels; ++i)
+            {
+                const channel_t *c      = &vChannels[i];
+                const delay_line_t *dl  = &c->sDelay;
+
+                snapshot_channel_t sc;
+                for (size_t j=0; j<DL_TOTAL; ++j)
+                {
+                    sc.vSize[j]             = uint32_t(dl->vSize[j]);
+                    sc.vHead[j]             = uint32_t(dl->vHead[j]);
+                }
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                {
+                    sc.vGainLevel[j]        = c->vVca[j].fGainLevel;
+                    sc.vEnvLevel[j]         = (rec != NULL) ? rec->vEnv[i][j] : 0.0f;
+                }
+                memcpy(ptr, &sc, sizeof(sc));
+                ptr                    += sizeof(sc);
+
+                for (size_t j=0; j<DL_TOTAL; ++j)
+                {
+                    const size_t bytes      = dl->vSize[j] * sizeof(float);
+                    memcpy(ptr, dl->vLane[j], bytes);
+                    ptr                    += bytes;
+                }
+            }
+
+            return total;
+        }
+
+        status_t gott_compressor::restore_snapshot(const void *src, size_t size)
+        {
+            rt_check();
+
+            if ((src == NULL) || (size < sizeof(snapshot_header_t)))
+                return STATUS_CORRUPTED;
+
+            const uint8_t *ptr      = static_cast<const uint8_t *>(src);
+            const uint8_t *end      = &ptr[size];
+
+            // Validate header
+            snapshot_header_t hdr;
+            memcpy(&hdr, ptr, sizeof(hdr));
+            ptr                    += sizeof(hdr);
+            if ((hdr.nMagic != SNAPSHOT_MAGIC) || (hdr.nVersion != SNAPSHOT_VERSION))
+                return STATUS_BAD_FORMAT;
+            if (hdr.nSize > size)
+                return STATUS_CORRUPTED;
+            switch (hdr.nBypassState)
+            {
+                case BYP_ACTIVE:
+                case BYP_FADE_OUT:
+                case BYP_SUSPENDED:
+                case BYP_WARM_UP:
+                    break;
+                default:
+                    return STATUS_CORRUPTED;
+            }
+
+            // The configuration should be applied before restoring the state
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            if ((vChannels == NULL) ||
+                (hdr.nSampleRate != uint32_t(fSampleRate)) ||
+                (hdr.nMode != uint32_t(nMode)) ||
+                (hdr.nChannels != channels) ||
+                (hdr.nBands != nBands))
+                return STATUS_BAD_STATE;
+
+            // Read channel records
+            float env[2 * meta::gott_compressor::BANDS_MAX];
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                delay_line_t *dl        = &c->sDelay;
+
+                snapshot_channel_t sc;
+                if (size_t(end - ptr) < sizeof(sc))
+                    return STATUS_CORRUPTED;
+                memcpy(&sc, ptr, sizeof(sc));
+                ptr                    += sizeof(sc);
+
+                for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                {
+                    c->vVca[j].fGainLevel   = sc.vGainLevel[j];
+                    env[i * meta::gott_compressor::BANDS_MAX + j]   = sc.vEnvLevel[j];
+                }
+
+                // Delay lanes are restored only if their layout matches the current one,
+                // otherwise they keep silence and only the detectors are primed
+                for (size_t j=0; j<DL_TOTAL; ++j)
+                {
+                    const size_t bytes      = sc.vSize[j] * sizeof(float);
+                    if (size_t(end - ptr) < bytes)
+                        return STATUS_CORRUPTED;
+
+                    if ((sc.vSize[j] == dl->vSize[j]) && (sc.vHead[j] < sc.vSize[j]) && (hdr.nXOver == uint32_t(enXOver)))
+                    {
+                        memcpy(dl->vLane[j], ptr, bytes);
+                        dl->vHead[j]            = sc.vHead[j];
+                    }
+                    ptr                    += bytes;
+                }
+            }
+
+            // Restore the state of gain transitions. The bypass state should follow the current
+            // bypass switch, the saved state is kept only if it does not contradict it
+            const size_t settle     = bypass_fade_samples();
+            if (pBypass->value() >= 0.5f)
+            {
+                nBypassState            = (hdr.nBypassState == BYP_SUSPENDED) ? BYP_SUSPENDED : BYP_FADE_OUT;
+                nBypassCounter          =
+                    (hdr.nBypassState == BYP_SUSPENDED) ? 0 :
+                    (hdr.nBypassState == BYP_FADE_OUT) ? lsp_min(size_t(hdr.nBypassCounter), settle) :
+                    settle;
+            }
+            else if (hdr.nBypassState == BYP_ACTIVE)
+            {
+                nBypassState            = BYP_ACTIVE;
+                nBypassCounter          = lsp_min(size_t(hdr.nBypassCounter), settle);
+            }
+            else
+            {
+                nBypassState            = BYP_WARM_UP;
+                nBypassCounter          = warm_up_samples();
+            }
+            for (size_t i=0; i<channels; ++i)
+                vChannels[i].sBypass.set_bypass(nBypassState != BYP_ACTIVE);
+
+            fOldDryGain             = hdr.fOldDryGain;
+            fOldWetGain             = hdr.fOldWetGain;
+
+            // Bring envelopes to the saved levels, this takes the time of the caller, not of process()
+            prime_detectors(env);
+
+            return STATUS_OK;
+        }
+
+        size_t gott_compressor::bypass_fade_samples() const
+        {
+            // dspu::Bypass completes the cross-fade in the configured time rounded up to samples
+            return size_t(dspu::millis_to_samples(fSampleRate, meta::gott_compressor::BYPASS_FADE_TIME)) + 1;
+        }
+
+        size_t gott_compressor::warm_up_samples() const
+        {
+            // Delay lines should be filled and envelopes should settle
+            const delay_line_t *dl  = &vChannels[0].sDelay;
+            return dl->nLookahead + dl->nXOver +
+                dspu::millis_to_samples(fSampleRate, fMaxAttack + fScReact + meta::gott_compressor::BYPASS_WARM_UP_TIME);
+        }
+
+        void gott_compressor::prime_detectors(const float *env)
+        {
+            const size_t channels   = (nMode == GOTT_MONO) ? 1 : 2;
+            const float sc_gain     = (fScPreamp > 0.0f) ? 1.0f / fScPreamp : 0.0f;
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                for (size_t j=0; j<nBands; ++j)
+                {
+                    band_vca_t *v       = &vChannels[i].vVca[j];
+                    band_t *b           = &vChannels[i].vBands[j];
+                    const float level   = env[i * meta::gott_compressor::BANDS_MAX + j];
+                    if ((!v->bEnabled) || (level <= 0.0f))
+                        continue;
+
+                    // The internal state of the detector is not accessible, so feed it with
+                    // the constant signal at the saved envelope level until it settles
+                    const float time    = (lsp_max(b->fAttackTime, 0.0f) + lsp_max(fScReact, 0.0f)) * meta::gott_compressor::SNAPSHOT_PRIME_MUL;
+                    const size_t count  = dspu::millis_to_samples(fSampleRate, time);
+
+                    for (size_t offset=0; offset < count; )
+                    {
+                        const size_t to_do  = lsp_min(count - offset, nBlockSize);
+
+                        for (size_t k=0; k<channels; ++k)
+                            dsp::fill(vSC[k], level * sc_gain, to_do);
+                        b->sSC.process(vBuffer, const_cast<const float **>(vSC), to_do);
+                        dsp::mul_k2(vBuffer, fScPreamp, to_do);
+                        b->sProc.process(v->vVCA, vEnv, vBuffer, to_do);
+
+                        offset             += to_do;
+                    }
+                }
+            }
+        }
+
+        void gott_compressor::rt_check()
+        {
+            // Allocations, locks and system calls may block the audio thread. Only count
+            // the violation: reporting it from here would not be RT-safe either
+            if (nRtDepth > 0)
+                atomic_add(&nRtViolations, 1);
+        }
+
+        size_t gott_compressor::collect_recorder(rec_frame_t *dst, uint32_t *head) const
+        {
+            static constexpr size_t frames = meta::gott_compressor::RECORDER_FRAMES;
+
+            // Take the snapshot of recorded frames in chronological order
+            const uint32_t last     = atomic_load(&nRecHead);
+            const size_t count      = lsp_min(last, uint32_t(frames));
+            for (size_t i=0; i<count; ++i)
+                dst[i]                  = vRecFrames[(last - count + i) & (frames - 1)];
+
+            // Drop the oldest frames that have been overwritten while copying,
+            // including the frame that may be written right now
+            const size_t written    = uint32_t(atomic_load(&nRecHead) - last) + 1;
+            const size_t skip       = (written + count > frames) ? lsp_min(written + count - frames, count) : 0;
+            if (skip > 0)
+                memmove(dst, &dst[skip], (count - skip) * sizeof(rec_frame_t));
+
+            *head                   = last;
+            return count - skip;
+        }
+
+        void gott_compressor::dump_recorder(dspu::IStateDumper *v) const
+        {
+            static constexpr size_t frames = meta::gott_compressor::RECORDER_FRAMES;
+
+            // The dump may be requested from the audio thread, so frames are dumped in place
+            // in chronological order. A frame written concurrently may appear torn
+            const uint32_t head     = atomic_load(&nRecHead);
+            const size_t count      = lsp_min(head, uint32_t(frames));
+
+            v->write("nRecHead", head);
+            v->begin_array("vRecFrames", vRecFrames, count);
+            lsp_finally { v->end_array(); };
+
+            for (size_t i=0; i<count; ++i)
+            {
+                const rec_frame_t *f    = &vRecFrames[(head - count + i) & (frames - 1)];
+
+                v->begin_object(f, sizeof(rec_frame_t));
+                lsp_finally { v->end_object(); };
+
+                v->write("nSamples", f->nSamples);
+                v->write("fProt", f->fProt);
+                v->writev("vIn", f->vIn, 2);
+                v->writev("vOut", f->vOut, 2);
+                v->writev("vEnv", &f->vEnv[0][0], 2 * meta::gott_compressor::BANDS_MAX);
+                v->writev("vVCAMin", &f->vVCAMin[0][0], 2 * meta::gott_compressor::BANDS_MAX);
+                v->writev("vVCAMax", &f->vVCAMax[0][0], 2 * meta::gott_compressor::BANDS_MAX);
+            }
+        }
+
         void gott_compressor::dump(dspu::IStateDumper *v) const
         {
             plug::Module::dump(v);
@@ -2007,6 +4758,8 @@ namespace lsp
                 v->write("fLinkToSc", sPremix.fLinkToSc);
                 v->write("fScToIn", sPremix.fScToIn);
                 v->write("fScToLink", sPremix.fScToLink);
+                v->writev("vMatrix", &sPremix.vMatrix[0][0], PM_TOTAL * PM_TOTAL);
+                v->writev("vMask", sPremix.vMask, PM_TOTAL);
 
                 v->writev("vIn", sPremix.vIn, 2);
                 v->writev("vOut", sPremix.vOut, 2);
@@ -2028,17 +4781,35 @@ namespace lsp
             v->write("nMode", nMode);
             v->write("nBands", nBands);
             v->write("enXOver", enXOver);
+            v->write("nBlockSize", nBlockSize);
+            v->write("nHostBlock", nHostBlock);
+            v->write("nHostPeak", nHostPeak);
+            v->write("nHostTime", nHostTime);
             v->write("nScType", nScType);
+            v->write("nScMode", nScMode);
+            v->write("nScSource", nScSource);
+            v->write("fScReact", fScReact);
+            v->write("fMaxAttack", fMaxAttack);
             v->write("bSidechain", bSidechain);
             v->write("bProt", bProt);
             v->write("bEnvUpdate", bEnvUpdate);
             v->write("bStereoSplit", bStereoSplit);
+            v->write("nBypassState", nBypassState);
+            v->write("nBypassCounter", nBypassCounter);
             v->write("fInGain", fInGain);
             v->write("fDryGain", fDryGain);
             v->write("fWetGain", fWetGain);
+            v->write("fOldDryGain", fOldDryGain);
+            v->write("fOldWetGain", fOldWetGain);
+            v->write("nDryHold", nDryHold);
+            v->write("nWetHold", nWetHold);
+            v->write("bDryOn", bDryOn);
+            v->write("bWetOn", bWetOn);
             v->write("fScPreamp", fScPreamp);
             v->write("nEnvBoost", nEnvBoost);
             v->write("fZoom", fZoom);
+            v->write("fGrTime", fGrTime);
+            v->write("fRefreshRate", fRefreshRate);
             v->writev("vSplits", vSplits, meta::gott_compressor::BANDS_MAX - 1);
             {
                 v->begin_array("vChannels", vChannels, channels);
@@ -2051,12 +4822,39 @@ namespace lsp
                     v->write_object("sBypass", &c->sBypass);
                     v->write_object_array("sEnvBoost", c->sEnvBoost, 2);
                     v->write_object("sDryEq", &c->sBypass);
-                    v->write_object("sFFTXOver", &c->sFFTXOver);
-                    v->write_object("sDelay", &c->sBypass);
-                    v->write_object("sDryDelay", &c->sDryDelay);
-                    v->write_object("sAnDelay", &c->sAnDelay);
-                    v->write_object("sScDelay", &c->sScDelay);
-                    v->write_object("sXOverDelay", &c->sXOverDelay);
+                    v->write_object("pFFTXOver", c->pFFTXOver);
+                    v->begin_object("sDelay", &c->sDelay, sizeof(delay_line_t));
+                    {
+                        v->writev("vLane", c->sDelay.vLane, DL_TOTAL);
+                        v->writev("vSize", c->sDelay.vSize, DL_TOTAL);
+                        v->writev("vHead", c->sDelay.vHead, DL_TOTAL);
+                        v->write("nLookahead", c->sDelay.nLookahead);
+                        v->write("nXOver", c->sDelay.nXOver);
+                    }
+                    v->end_object();
+
+                    {
+                        v->begin_array("vVca", c->vVca, meta::gott_compressor::BANDS_MAX);
+                        lsp_finally { v->end_array(); };
+
+                        for (size_t j=0; j<meta::gott_compressor::BANDS_MAX; ++j)
+                        {
+                            const band_vca_t *bv    = &c->vVca[j];
+
+                            v->begin_object(bv, sizeof(band_vca_t));
+                            lsp_finally { v->end_object(); };
+
+                            v->write("vBuffer", bv->vBuffer);
+                            v->write("vVCA", bv->vVCA);
+                            v->write("vLeader", bv->vLeader);
+                            v->write("fVcaHold", bv->fVcaHold);
+                            v->write("fMakeup", bv->fMakeup);
+                            v->write("fGainLevel", bv->fGainLevel);
+                            v->write("nFilterID", bv->nFilterID);
+                            v->write("bEnabled", bv->bEnabled);
+                            v->write("bMute", bv->bMute);
+                        }
+                    }
 
                     {
                         v->begin_array("vBands", c->vBands, meta::gott_compressor::BANDS_MAX);
@@ -2076,8 +4874,6 @@ namespace lsp
                             v->write_object("sRejFilter", &b->sRejFilter);
                             v->write_object("sAllFilter", &b->sAllFilter);
 
-                            v->write("vVCA", b->vVCA);
-                            v->write("vCurveBuffer", b->vCurveBuffer);
                             v->write("vFilterBuffer", b->vFilterBuffer);
                             v->write("vSidechainBuffer", b->vSidechainBuffer);
 
@@ -2086,34 +4882,32 @@ namespace lsp
                             v->write("fDownThresh", b->fDownThresh);
                             v->write("fUpRatio", b->fUpRatio);
                             v->write("fDownRatio", b->fDownRatio);
+                            v->write("fKnee", b->fKnee);
                             v->write("fAttackTime", b->fAttackTime);
                             v->write("fReleaseTime", b->fReleaseTime);
-                            v->write("fMakeup", b->fMakeup);
-                            v->write("fGainLevel", b->fGainLevel);
                             v->write("nSync", b->nSync);
-                            v->write("nFilterID", b->nFilterID);
-                            v->write("bEnabled", b->bEnabled);
                             v->write("bSolo", b->bSolo);
-                            v->write("bMute", b->bMute);
-
-                            v->write("pMinThresh", b->pMinThresh);
-                            v->write("pUpThresh", b->pUpThresh);
-                            v->write("pDownThresh", b->pDownThresh);
-                            v->write("pUpRatio", b->pUpRatio);
-                            v->write("pDownRatio", b->pDownRatio);
-                            v->write("pKnee", b->pKnee);
-                            v->write("pAttackTime", b->pAttackTime);
-                            v->write("pReleaseTime", b->pReleaseTime);
-                            v->write("pMakeup", b->pMakeup);
-
-                            v->write("pEnabled", b->pEnabled);
-                            v->write("pSolo", b->pSolo);
-                            v->write("pMute", b->pMute);
-                            v->write("pCurveMesh", b->pCurveMesh);
-                            v->write("pFreqMesh", b->pFreqMesh);
-                            v->write("pEnvLvl", b->pEnvLvl);
-                            v->write("pCurveLvl", b->pCurveLvl);
-                            v->write("pMeterGain", b->pMeterGain);
+                            v->write("bMuteSw", b->bMuteSw);
+                            v->write("bDirty", b->bDirty);
+
+                            v->write("pMinThresh", b->pPorts->pMinThresh);
+                            v->write("pUpThresh", b->pPorts->pUpThresh);
+                            v->write("pDownThresh", b->pPorts->pDownThresh);
+                            v->write("pUpRatio", b->pPorts->pUpRatio);
+                            v->write("pDownRatio", b->pPorts->pDownRatio);
+                            v->write("pKnee", b->pPorts->pKnee);
+                            v->write("pAttackTime", b->pPorts->pAttackTime);
+                            v->write("pReleaseTime", b->pPorts->pReleaseTime);
+                            v->write("pMakeup", b->pPorts->pMakeup);
+
+                            v->write("pEnabled", b->pPorts->pEnabled);
+                            v->write("pSolo", b->pPorts->pSolo);
+                            v->write("pMute", b->pPorts->pMute);
+                            v->write("pCurveMesh", b->pPorts->pCurveMesh);
+                            v->write("pFreqMesh", b->pPorts->pFreqMesh);
+                            v->write("pEnvLvl", b->pPorts->pEnvLvl);
+                            v->write("pCurveLvl", b->pPorts->pCurveLvl);
+                            v->write("pMeterGain", b->pPorts->pMeterGain);
                         }
                     }
 
@@ -2125,8 +4919,9 @@ namespace lsp
                     v->write("vBuffer", c->vBuffer);
                     v->write("vScBuffer", c->vScBuffer);
                     v->write("vInAnalyze", c->vInAnalyze);
-                    v->write("vTmpFilterBuffer", c->vTmpFilterBuffer);
                     v->write("vFilterBuffer", c->vFilterBuffer);
+                    v->writev("vAmpGain", c->vAmpGain, meta::gott_compressor::BANDS_MAX);
+                    v->write("bAmpSync", c->bAmpSync);
 
                     v->write("nAnInChannel", c->nAnInChannel);
                     v->write("nAnOutChannel", c->nAnOutChannel);
@@ -2143,6 +4938,7 @@ namespace lsp
                     v->write("pFftIn", c->pFftIn);
                     v->write("pFftOut", c->pFftOut);
                     v->write("pAmpGraph", c->pAmpGraph);
+                    v->write("pGrHistory", c->pGrHistory);
                     v->write("pInLvl", c->pInLvl);
                     v->write("pOutLvl", c->pOutLvl);
                 }
@@ -2154,10 +4950,29 @@ namespace lsp
             v->write("vTr", vTr);
             v->write("vPFc", vPFc);
             v->write("vRFc", vRFc);
+            v->write("vTmpFilter", vTmpFilter);
             v->write("vCurveBuffer", vCurveBuffer);
             v->write("vFreqBuffer", vFreqBuffer);
             v->write("vFreqIndexes", vFreqIndexes);
+            v->write("pFreqGrid", pFreqGrid);
             v->write("pIDisplay", pIDisplay);
+            {
+                v->begin_object("sIDisplay", &sIDisplay, sizeof(sIDisplay));
+                lsp_finally { v->end_object(); };
+
+                v->write("vFreqs", sIDisplay.vFreqs);
+                v->write("nWidth", sIDisplay.nWidth);
+                v->write("nHeight", sIDisplay.nHeight);
+                v->write("fZoom", sIDisplay.fZoom);
+                v->write("nGridX", sIDisplay.nGridX);
+                v->write("nGridY", sIDisplay.nGridY);
+                v->writev("vGridX", sIDisplay.vGridX, sIDisplay.nGridX);
+                v->writev("vGridY", sIDisplay.vGridY, sIDisplay.nGridY);
+                v->write("fZy", sIDisplay.fZy);
+                v->write("fDy", sIDisplay.fDy);
+            }
+            v->write("bIDisplaySync", bIDisplaySync);
+            v->write("bIDisplayBypass", bIDisplayBypass);
 
             v->write("pBypass", pBypass);
             v->write("pMode", pMode);
@@ -2175,6 +4990,7 @@ namespace lsp
             v->write("pReactivity", pReactivity);
             v->write("pShiftGain", pShiftGain);
             v->write("pZoom", pZoom);
+            v->write("pGrTime", pGrTime);
             v->write("pEnvBoost", pEnvBoost);
             v->writev("pSplits", pSplits, meta::gott_compressor::BANDS_MAX - 1);
             v->write("pExtraBand", pExtraBand);
@@ -2182,6 +4998,70 @@ namespace lsp
             v->write("pStereoSplit", pStereoSplit);
 
             v->write("pData", pData);
+            v->write("nDataSize", nDataSize);
+            dump_xover_state(v, "sXOver", &sXOver);
+            dump_xover_state(v, "sXOverNew", &sXOverNew);
+            dump_xover_state(v, "sXOverGarbage", &sXOverGarbage);
+            v->write("pXOverLoader", pXOverLoader);
+            dump_block_state(v, "sBlock", &sBlock);
+            dump_block_state(v, "sBlockNew", &sBlockNew);
+            dump_block_state(v, "sBlockGarbage", &sBlockGarbage);
+            v->write("pBlockLoader", pBlockLoader);
+            v->write("pAnLoader", pAnLoader);
+            v->write("bAnalyzer", bAnalyzer);
+            v->write("bAnRequest", bAnRequest);
+            v->write("nVcaShare", nVcaShare);
+            v->write("pVcaBus", pVcaBus);
+            v->write("pVcaBusNew", pVcaBusNew);
+            v->write("pVcaBusGarbage", pVcaBusGarbage);
+            v->write("pVcaLoader", pVcaLoader);
+            v->write("nVcaGroup", nVcaGroup);
+            v->write("nVcaGroupNew", nVcaGroupNew);
+            v->write("nVcaTail", nVcaTail);
+            v->write("nVcaHold", nVcaHold);
+            v->write("fVcaMix", fVcaMix);
+            v->write("bVcaLeader", bVcaLeader);
+            v->write("bVcaSync", bVcaSync);
+            v->write("pVcaShare", pVcaShare);
+            v->write("pVcaGroup", pVcaGroup);
+            v->write("pStats", pStats);
+            v->write("nStatsOwner", nStatsOwner);
+            v->write("nRtViolations", int(atomic_load(&nRtViolations)));
+            dump_recorder(v);
+        }
+
+        status_t gott_compressor::save_recorder(const char *path) const
+        {
+            rt_check();
+
+            rec_header_t hdr;
+            hdr.nMagic              = RECORDER_MAGIC;
+            hdr.nVersion            = RECORDER_VERSION;
+            hdr.nFrameSize          = sizeof(rec_frame_t);
+            hdr.nChannels           = (nMode == GOTT_MONO) ? 1 : 2;
+            hdr.nBands              = nBands;
+            hdr.nSampleRate         = fSampleRate;
+
+            // The copy is needed only while the file is written
+            rec_frame_t *frames     = static_cast<rec_frame_t *>(malloc(sizeof(rec_frame_t) * meta::gott_compressor::RECORDER_FRAMES));
+            if (frames == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally { free(frames); };
+            hdr.nFrames             = collect_recorder(frames, &hdr.nHead);
+
+            io::NativeFile fd;
+            status_t res            = fd.open(path, io::File::FM_WRITE_NEW);
+            if (res != STATUS_OK)
+                return res;
+            lsp_finally { fd.close(); };
+
+            const size_t data_size  = hdr.nFrames * sizeof(rec_frame_t);
+            if (fd.write(&hdr, sizeof(hdr)) != ssize_t(sizeof(hdr)))
+                return STATUS_IO_ERROR;
+            if (fd.write(frames, data_size) != ssize_t(data_size))
+                return STATUS_IO_ERROR;
+
+            return STATUS_OK;
         }
 
     } /* namespace plugins */
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_HELPERS_GOTT_HOST_H_
+#define TEST_HELPERS_GOTT_HOST_H_
+
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/ipc/ITask.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/plugins/gott_compressor.h>
+
+namespace lsp
+{
+    namespace gott_test
+    {
+        /**
+         * Plugin port which keeps the value or the audio buffer assigned by the test.
+         * Like in real wrappers, the value of the bypass port is inverted: the test sets
+         * the "enabled" state and the plugin gets the bypass state
+         */
+        class Port: public plug::IPort
+        {
+            private:
+                float                   fValue;
+                float                  *vBuffer;
+
+            public:
+                explicit Port(const meta::port_t *meta): plug::IPort(meta)
+                {
+                    fValue          = (meta->role == meta::R_BYPASS) ? meta->max - meta->start : meta->start;
+                    vBuffer         = NULL;
+                }
+
+                virtual ~Port() override
+                {
+                    if (vBuffer != NULL)
+                        delete [] vBuffer;
+                    vBuffer         = NULL;
+                }
+
+            public:
+                virtual float value() override          { return fValue;    }
+                virtual void set_value(float value) override
+                {
+                    fValue          = (pMetadata->role == meta::R_BYPASS) ? pMetadata->max - value : value;
+                }
+                virtual void *buffer() override         { return vBuffer;   }
+
+            public:
+                inline void set_buffer(float *buf)      { vBuffer = buf;    }
+        };
+
+        /**
+         * Executor which runs tasks only when the test asks for it, outside of the process() call
+         */
+        class Executor: public ipc::IExecutor
+        {
+            private:
+                static constexpr size_t TASKS_MAX   = 16;
+
+                ipc::ITask             *vTasks[TASKS_MAX];
+                size_t                  nTasks;
+
+            public:
+                Executor()
+                {
+                    nTasks          = 0;
+                }
+
+            public:
+                virtual bool submit(ipc::ITask *task) override
+                {
+                    if ((!task->idle()) || (nTasks >= TASKS_MAX))
+                        return false;
+
+                    change_task_state(task, ipc::ITask::TS_SUBMITTED);
+                    vTasks[nTasks++]    = task;
+                    return true;
+                }
+
+                virtual void shutdown() override
+                {
+                    run_tasks();
+                }
+
+            public:
+                void run_tasks()
+                {
+                    for (size_t i=0; i<nTasks; ++i)
+                        run_task(vTasks[i]);
+                    nTasks          = 0;
+                }
+        };
+
+        /**
+         * Plugin with access to the internal state for the checks
+         */
+        class Module: public plugins::gott_compressor
+        {
+            public:
+                using plugins::gott_compressor::snapshot_header_t;
+                using plugins::gott_compressor::BYP_ACTIVE;
+                using plugins::gott_compressor::BYP_FADE_OUT;
+                using plugins::gott_compressor::BYP_SUSPENDED;
+                using plugins::gott_compressor::BYP_WARM_UP;
+
+            public:
+                explicit Module(const meta::plugin_t *meta): plugins::gott_compressor(meta) {}
+
+            public:
+                inline uint32_t bypass_state() const            { return nBypassState; }
+                static inline size_t rt_violations()            { return atomic_load(&nRtViolations); }
+        };
+
+        /**
+         * Minimal host for the plugin: owns the plugin, its ports and the executor
+         */
+        class Host: public plug::IWrapper
+        {
+            private:
+                Module                     *pModule;
+                Executor                    sExecutor;
+                plug::position_t            sPosition;
+                plug::IPort               **vPorts;
+                size_t                      nPorts;
+                float                      *vIn[2];
+                float                      *vOut[2];
+                float                      *vSc[2];
+                size_t                      nChannels;
+
+            public:
+                explicit Host(Module *module): plug::IWrapper(module, NULL)
+                {
+                    pModule         = module;
+                    vPorts          = NULL;
+                    nPorts          = 0;
+                    nChannels       = 0;
+                    for (size_t i=0; i<2; ++i)
+                    {
+                        vIn[i]          = NULL;
+                        vOut[i]         = NULL;
+                        vSc[i]          = NULL;
+                    }
+                    plug::position_t::init(&sPosition);
+                }
+
+                virtual ~Host() override
+                {
+                    destroy();
+                }
+
+            public:
+                virtual ipc::IExecutor *executor() override         { return &sExecutor; }
+                virtual const plug::position_t *position() override { return &sPosition; }
+
+            public:
+                static Host *create(const meta::plugin_t *meta, long sample_rate, size_t max_block)
+                {
+                    Host *host      = new Host(new Module(meta));
+                    if (!host->init(sample_rate, max_block))
+                    {
+                        delete host;
+                        return NULL;
+                    }
+                    return host;
+                }
+
+                bool init(long sample_rate, size_t max_block)
+                {
+                    const meta::plugin_t *meta = pModule->metadata();
+
+                    for (const meta::port_t *p = meta->ports; p->id != NULL; ++p)
+                        ++nPorts;
+
+                    vPorts          = new plug::IPort *[nPorts];
+                    for (size_t i=0; i<nPorts; ++i)
+                    {
+                        const meta::port_t *p   = &meta->ports[i];
+                        Port *port              = new Port(p);
+                        vPorts[i]               = port;
+
+                        const bool in           = meta::is_audio_in_port(p);
+                        if ((!in) && (!meta::is_audio_out_port(p)))
+                            continue;
+
+                        float *buf              = new float[max_block];
+                        dsp::fill_zero(buf, max_block);
+                        port->set_buffer(buf);
+
+                        if (!in)
+                            bind_audio(vOut, buf);
+                        else if (!strncmp(p->id, "sc", 2))
+                            bind_audio(vSc, buf);
+                        else
+                            bind_audio(vIn, buf);
+                    }
+                    nChannels       = (vIn[1] != NULL) ? 2 : 1;
+
+                    pModule->init(this, vPorts);
+                    pModule->set_sample_rate(sample_rate);
+                    pModule->activate();
+                    pModule->update_settings();
+                    sExecutor.run_tasks();
+
+                    return true;
+                }
+
+                void destroy()
+                {
+                    if (pModule != NULL)
+                    {
+                        // Tasks may only be left queued, run them before the plugin waits for them
+                        sExecutor.run_tasks();
+
+                        pModule->deactivate();
+                        pModule->destroy();
+                        delete pModule;
+                        pModule         = NULL;
+                    }
+
+                    if (vPorts != NULL)
+                    {
+                        for (size_t i=0; i<nPorts; ++i)
+                            delete vPorts[i];
+                        delete [] vPorts;
+                        vPorts          = NULL;
+                    }
+                    nPorts          = 0;
+                }
+
+            public:
+                inline Module *module()                     { return pModule;       }
+                inline size_t channels() const              { return nChannels;     }
+                inline float *input(size_t ch)              { return vIn[ch];       }
+                inline float *output(size_t ch)             { return vOut[ch];      }
+                inline float *sidechain(size_t ch)          { return vSc[ch];       }
+                inline bool has_sidechain() const           { return vSc[0] != NULL; }
+
+                Port *port(const char *id)
+                {
+                    for (size_t i=0; i<nPorts; ++i)
+                        if (!strcmp(vPorts[i]->metadata()->id, id))
+                            return static_cast<Port *>(vPorts[i]);
+                    return NULL;
+                }
+
+                bool set(const char *id, float value)
+                {
+                    Port *p         = port(id);
+                    if (p == NULL)
+                        return false;
+                    p->set_value(value);
+                    return true;
+                }
+
+                /**
+                 * Switch the bypass of the plugin, the value is written like the host does it
+                 */
+                bool set_bypass(bool bypass)
+                {
+                    for (size_t i=0; i<nPorts; ++i)
+                    {
+                        const meta::port_t *p   = vPorts[i]->metadata();
+                        if (p->role != meta::R_BYPASS)
+                            continue;
+                        vPorts[i]->set_value((bypass) ? p->min : p->max);
+                        return true;
+                    }
+                    return false;
+                }
+
+                float get(const char *id)
+                {
+                    Port *p         = port(id);
+                    return (p != NULL) ? p->value() : 0.0f;
+                }
+
+                /**
+                 * Apply changed port values and run the tasks the plugin has submitted
+                 */
+                void commit()
+                {
+                    pModule->update_settings();
+                    sExecutor.run_tasks();
+                }
+
+                inline void run_tasks()                     { sExecutor.run_tasks(); }
+                inline void process(size_t samples)         { pModule->process(samples); }
+
+            private:
+                static void bind_audio(float **list, float *buf)
+                {
+                    if (list[0] == NULL)
+                        list[0]         = buf;
+                    else if (list[1] == NULL)
+                        list[1]         = buf;
+                }
+        };
+
+    } /* namespace gott_test */
+} /* namespace lsp */
+
+#endif /* TEST_HELPERS_GOTT_HOST_H_ */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_HELPERS_RECORDER_H_
+#define TEST_HELPERS_RECORDER_H_
+
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#include <private/plugins/gott_compressor.h>
+
+namespace lsp
+{
+    namespace gott_test
+    {
+        typedef plugins::gott_compressor::rec_header_t  rec_header_t;
+        typedef plugins::gott_compressor::rec_frame_t   rec_frame_t;
+
+        static constexpr uint32_t RECORDER_MAGIC        = 0x47545243;   // 'GTRC'
+        static constexpr uint32_t RECORDER_VERSION      = 1;
+
+        /**
+         * Contents of the flight recorder file
+         */
+        typedef struct recorder_t
+        {
+            rec_header_t            sHeader;
+            rec_frame_t            *vFrames;
+        } recorder_t;
+
+        inline void free_recorder(recorder_t *rec)
+        {
+            if (rec->vFrames != NULL)
+            {
+                free(rec->vFrames);
+                rec->vFrames        = NULL;
+            }
+        }
+
+        /**
+         * Read the flight recorder file written by gott_compressor::save_recorder()
+         *
+         * @param rec the file contents, should be freed with free_recorder()
+         * @param path path to the file
+         * @return status of operation
+         */
+        inline status_t read_recorder(recorder_t *rec, const char *path)
+        {
+            rec->vFrames        = NULL;
+
+            io::NativeFile fd;
+            status_t res        = fd.open(path, io::File::FM_READ);
+            if (res != STATUS_OK)
+                return res;
+            lsp_finally { fd.close(); };
+
+            rec_header_t *hdr   = &rec->sHeader;
+            if (fd.read(hdr, sizeof(rec_header_t)) != ssize_t(sizeof(rec_header_t)))
+                return STATUS_CORRUPTED;
+            if ((hdr->nMagic != RECORDER_MAGIC) || (hdr->nVersion != RECORDER_VERSION))
+                return STATUS_BAD_FORMAT;
+            if ((hdr->nFrameSize != sizeof(rec_frame_t)) ||
+                (hdr->nChannels < 1) || (hdr->nChannels > 2) ||
+                (hdr->nBands > meta::gott_compressor::BANDS_MAX) ||
+                (hdr->nFrames > meta::gott_compressor::RECORDER_FRAMES))
+                return STATUS_CORRUPTED;
+
+            const size_t size   = hdr->nFrames * sizeof(rec_frame_t);
+            rec->vFrames        = static_cast<rec_frame_t *>(malloc(lsp_max(size, sizeof(rec_frame_t))));
+            if (rec->vFrames == NULL)
+                return STATUS_NO_MEM;
+            if (fd.read(rec->vFrames, size) != ssize_t(size))
+            {
+                free_recorder(rec);
+                return STATUS_CORRUPTED;
+            }
+
+            return STATUS_OK;
+        }
+
+    } /* namespace gott_test */
+} /* namespace lsp */
+
+#endif /* TEST_HELPERS_RECORDER_H_ */
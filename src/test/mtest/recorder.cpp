@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/mtest.h>
+
+#include "../helpers/recorder.h"
+
+// Print the flight recorder file as CSV: one line per band of each frame
+MTEST_BEGIN("plugins.gott_compressor", recorder)
+
+    MTEST_MAIN
+    {
+        MTEST_ASSERT_MSG(argc > 0, "Usage: recorder <file.rec>");
+
+        gott_test::recorder_t rec;
+        status_t res = gott_test::read_recorder(&rec, argv[0]);
+        MTEST_ASSERT_MSG(res == STATUS_OK, "Could not read file '%s', code=%d", argv[0], int(res));
+        lsp_finally { gott_test::free_recorder(&rec); };
+
+        const gott_test::rec_header_t *hdr = &rec.sHeader;
+        printf("# channels=%d, bands=%d, sample_rate=%d, frames=%d\n",
+            int(hdr->nChannels), int(hdr->nBands), int(hdr->nSampleRate), int(hdr->nFrames));
+        printf("frame;samples;prot;channel;in;out;band;env;vca_min;vca_max\n");
+
+        const uint32_t first = hdr->nHead - hdr->nFrames;
+        for (size_t i=0; i<hdr->nFrames; ++i)
+        {
+            const gott_test::rec_frame_t *f = &rec.vFrames[i];
+            for (size_t j=0; j<hdr->nChannels; ++j)
+                for (size_t k=0; k<hdr->nBands; ++k)
+                    printf("%u;%d;%f;%d;%f;%f;%d;%f;%f;%f\n",
+                        (unsigned int)(first + i), int(f->nSamples), f->fProt,
+                        int(j), f->vIn[j], f->vOut[j],
+                        int(k), f->vEnv[j][k], f->vVCAMin[j][k], f->vVCAMax[j][k]);
+        }
+    }
+
+MTEST_END
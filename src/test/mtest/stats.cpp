@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/SharedMem.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/mtest.h>
+
+#include <private/plugins/gott_compressor.h>
+
+#include <atomic>
+
+namespace
+{
+    typedef lsp::plugins::gott_compressor::stats_header_t   stats_header_t;
+    typedef lsp::plugins::gott_compressor::stats_slot_t     stats_slot_t;
+
+    static constexpr uint32_t STATS_MAGIC       = 0x47545453;   // 'GTTS'
+    static constexpr uint32_t STATS_VERSION     = 2;
+    static constexpr size_t STATS_READ_ATTEMPTS = 16;
+}
+
+// Print the statistics of all instances published to the statistics segment
+MTEST_BEGIN("plugins.gott_compressor", stats)
+
+    MTEST_MAIN
+    {
+        MTEST_ASSERT_MSG(argc > 0, "Usage: stats <segment> [period_ms] [count]");
+        const size_t period = (argc > 1) ? atoi(argv[1]) : 1000;
+        const size_t count  = (argc > 2) ? atoi(argv[2]) : 1;
+
+        LSPString name;
+        MTEST_ASSERT(name.set_native(argv[0]));
+
+        // Map the segment for reading only, the monitor never modifies it
+        const size_t size   = sizeof(stats_header_t) + sizeof(stats_slot_t) * meta::gott_compressor::STATS_SLOTS;
+        ipc::SharedMem shm;
+        status_t res        = shm.open(&name, ipc::SharedMem::SHM_READ, size);
+        if (res == STATUS_OK)
+            res                 = shm.map(0, size);
+        MTEST_ASSERT_MSG(res == STATUS_OK, "Could not map segment '%s', code=%d", argv[0], int(res));
+        lsp_finally { shm.close(); };
+
+        // The header is valid only after the magic has been published
+        const stats_header_t *hdr = static_cast<const stats_header_t *>(shm.data());
+        const uint32_t magic    = atomic_load(const_cast<uint32_t *>(&hdr->nMagic));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        MTEST_ASSERT_MSG((magic == STATS_MAGIC) && (hdr->nVersion == STATS_VERSION) && (hdr->nSlotSize == sizeof(stats_slot_t)),
+            "Segment '%s' has unknown format", argv[0]);
+
+        const stats_slot_t *slots   = reinterpret_cast<const stats_slot_t *>(&hdr[1]);
+        const size_t num_slots      = lsp_min(hdr->nSlots, uint32_t(meta::gott_compressor::STATS_SLOTS));
+
+        for (size_t n=0; n<count; ++n)
+        {
+            if (n > 0)
+                system::sleep_msec(period);
+
+            printf("slot;pid;stamp;mode;xover;channels;bands;sample_rate;blocks;overloads;dsp_us;dsp_max_us;load;load_max;in_l;in_r;out_l;out_r\n");
+            for (size_t i=0; i<num_slots; ++i)
+            {
+                // Skip free slots and slots which could not be read consistently
+                if (!(atomic_load(const_cast<uint32_t *>(&slots[i].nOwner)) & 1))
+                    continue;
+
+                stats_slot_t st;
+                if (!plugins::gott_compressor::read_stats_slot(&slots[i], &st, STATS_READ_ATTEMPTS))
+                    continue;
+
+                printf("%d;%d;%u;%d;%d;%d;%d;%d;%u;%u;%f;%f;%f;%f;%f;%f;%f;%f\n",
+                    int(i), int(st.nPid), (unsigned int)(st.nStamp),
+                    int(st.nMode), int(st.nXOver), int(st.nChannels), int(st.nBands), int(st.nSampleRate),
+                    (unsigned int)(st.nBlocks), (unsigned int)(st.nOverloads),
+                    st.fDspTime, st.fDspTimeMax, st.fLoad, st.fLoadMax,
+                    st.vInLevel[0], st.vInLevel[1], st.vOutLevel[0], st.vOutLevel[1]);
+            }
+            printf("\n");
+        }
+    }
+
+MTEST_END
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+
+#include "../helpers/gott_host.h"
+
+namespace
+{
+    static const char *xover_names[] =
+    {
+        "classic",
+        "modern",
+        "linear"
+    };
+}
+
+// The host buffer size selects the internal block size, compare the per-sample
+// cost of process() for all crossover modes across the whole allowed range
+PTEST_BEGIN("plugins.gott_compressor", block_size, 5, 100)
+
+    void call(const meta::plugin_t *meta, size_t xover, size_t samples)
+    {
+        gott_test::Host *host   = gott_test::Host::create(meta, 48000, samples);
+        if (host == NULL)
+            return;
+        lsp_finally { delete host; };
+
+        host->set("mode", xover);
+        host->commit();
+
+        // Fill inputs with noise-like signal to keep all bands busy
+        uint32_t seed           = 0x1234567;
+        for (size_t i=0; i<host->channels(); ++i)
+        {
+            float *in               = host->input(i);
+            for (size_t j=0; j<samples; ++j)
+            {
+                seed                    = seed * 1664525 + 1013904223;
+                in[j]                   = float(int32_t(seed)) / float(0x80000000u) * 0.5f;
+            }
+        }
+
+        // Let the plugin reallocate buffers for the host buffer size and settle
+        for (size_t i=0; i<8; ++i)
+        {
+            host->process(samples);
+            host->run_tasks();
+        }
+
+        char buf[80];
+        snprintf(buf, sizeof(buf), "%s %s x %d", meta->uid, xover_names[xover], int(samples));
+        printf("Testing %s samples...\n", buf);
+
+        PTEST_LOOP(buf,
+            host->process(samples);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        const meta::plugin_t *list[] =
+        {
+            &meta::gott_compressor_mono,
+            &meta::gott_compressor_stereo
+        };
+
+        for (size_t i=0; i<sizeof(list)/sizeof(list[0]); ++i)
+            for (size_t xover=0; xover<3; ++xover)
+                for (size_t samples = meta::gott_compressor::BLOCK_SIZE_MIN;
+                    samples <= meta::gott_compressor::BLOCK_SIZE_MAX; samples <<= 1)
+                    call(list[i], xover, samples);
+    }
+
+PTEST_END
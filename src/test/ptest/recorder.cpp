@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+
+#include "../helpers/gott_host.h"
+
+// Compare the cost of process() with the cost of the work the flight recorder adds to each
+// block: minimum of the surge protector gain and VCA min/max of each band of each channel.
+// The recorder row should stay below 1% of the process row for the same block size.
+PTEST_BEGIN("plugins.gott_compressor", recorder, 5, 100)
+
+    void call(const meta::plugin_t *meta, size_t samples)
+    {
+        gott_test::Host *host   = gott_test::Host::create(meta, 48000, samples);
+        if (host == NULL)
+            return;
+        lsp_finally { delete host; };
+
+        const size_t channels   = host->channels();
+        const size_t bands      = meta::gott_compressor::BANDS_MAX;
+
+        uint32_t seed           = 0x7654321;
+        for (size_t i=0; i<channels; ++i)
+        {
+            float *in               = host->input(i);
+            for (size_t j=0; j<samples; ++j)
+            {
+                seed                    = seed * 1664525 + 1013904223;
+                in[j]                   = float(int32_t(seed)) / float(0x80000000u) * 0.5f;
+            }
+        }
+        for (size_t i=0; i<8; ++i)
+            host->process(samples);
+
+        float *vca              = static_cast<float *>(malloc(samples * sizeof(float)));
+        if (vca == NULL)
+            return;
+        lsp_finally { free(vca); };
+        dsp::copy(vca, host->input(0), samples);
+
+        plugins::gott_compressor::rec_frame_t frame;
+        char buf[80];
+
+        snprintf(buf, sizeof(buf), "%s process x %d", meta->uid, int(samples));
+        printf("Testing %s samples...\n", buf);
+        PTEST_LOOP(buf,
+            host->process(samples);
+        );
+
+        snprintf(buf, sizeof(buf), "%s recorder x %d", meta->uid, int(samples));
+        printf("Testing %s samples...\n", buf);
+        PTEST_LOOP(buf,
+            frame.nSamples          = samples;
+            frame.fProt             = dsp::min(vca, samples);
+            for (size_t i=0; i<channels; ++i)
+                for (size_t j=0; j<bands; ++j)
+                    dsp::minmax(vca, samples, &frame.vVCAMin[i][j], &frame.vVCAMax[i][j]);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        const meta::plugin_t *list[] =
+        {
+            &meta::gott_compressor_mono,
+            &meta::gott_compressor_stereo
+        };
+
+        for (size_t i=0; i<sizeof(list)/sizeof(list[0]); ++i)
+            for (size_t samples = meta::gott_compressor::BLOCK_SIZE_MIN;
+                samples <= meta::gott_compressor::BLOCK_SIZE_MAX; samples <<= 2)
+                call(list[i], samples);
+    }
+
+PTEST_END
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include "../helpers/gott_host.h"
+#include "../helpers/recorder.h"
+
+UTEST_BEGIN("plugins.gott_compressor", recorder)
+
+    UTEST_MAIN
+    {
+        static constexpr size_t BLOCK       = 512;
+        static constexpr size_t BLOCKS      = 100;
+
+        gott_test::Host *host   = gott_test::Host::create(&meta::gott_compressor_stereo, 48000, BLOCK);
+        UTEST_ASSERT(host != NULL);
+        lsp_finally { delete host; };
+
+        // Render a loud sine through the plugin, each call of process() records one frame
+        for (size_t i=0; i<BLOCKS; ++i)
+        {
+            for (size_t j=0; j<host->channels(); ++j)
+            {
+                float *in               = host->input(j);
+                for (size_t k=0; k<BLOCK; ++k)
+                    in[k]                   = 0.5f * sinf(2.0f * M_PI * 440.0f * (i * BLOCK + k) / 48000.0f);
+            }
+            host->process(BLOCK);
+        }
+
+        // Write the recorder file and read it back
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("%s" FILE_SEPARATOR_S "utest-%s.rec", tempdir(), full_name()));
+        printf("Writing flight recorder to %s\n", path.get_native());
+        UTEST_ASSERT(host->module()->save_recorder(path.get_native()) == STATUS_OK);
+
+        gott_test::recorder_t rec;
+        UTEST_ASSERT(gott_test::read_recorder(&rec, path.get_native()) == STATUS_OK);
+        lsp_finally { gott_test::free_recorder(&rec); };
+
+        const gott_test::rec_header_t *hdr = &rec.sHeader;
+        UTEST_ASSERT(hdr->nChannels == 2);
+        UTEST_ASSERT(hdr->nSampleRate == 48000);
+        UTEST_ASSERT(hdr->nFrames == BLOCKS);
+        UTEST_ASSERT(hdr->nHead == BLOCKS);
+
+        for (size_t i=0; i<hdr->nFrames; ++i)
+        {
+            const gott_test::rec_frame_t *f = &rec.vFrames[i];
+            UTEST_ASSERT_MSG(f->nSamples == BLOCK, "frame %d: nSamples=%d", int(i), int(f->nSamples));
+            for (size_t j=0; j<hdr->nChannels; ++j)
+            {
+                UTEST_ASSERT_MSG(f->vIn[j] > 0.0f, "frame %d: vIn[%d]=%f", int(i), int(j), f->vIn[j]);
+                for (size_t k=0; k<hdr->nBands; ++k)
+                    UTEST_ASSERT_MSG(f->vVCAMin[j][k] <= f->vVCAMax[j][k],
+                        "frame %d: vVCAMin[%d][%d]=%f > vVCAMax=%f",
+                        int(i), int(j), int(k), f->vVCAMin[j][k], f->vVCAMax[j][k]);
+            }
+        }
+    }
+
+UTEST_END
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/types.h>
+
+// The test replaces the allocator and the mutex functions of the C library, which is
+// possible only for the glibc. Trace output is not RT-safe, so the test is skipped in trace builds
+#if defined(PLATFORM_LINUX) && defined(__GLIBC__) && !defined(LSP_TRACE)
+
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <pthread.h>
+
+#include "../helpers/gott_host.h"
+
+extern "C"
+{
+    void   *__libc_malloc(size_t size);
+    void   *__libc_calloc(size_t nmemb, size_t size);
+    void   *__libc_realloc(void *ptr, size_t size);
+    void    __libc_free(void *ptr);
+    int     __pthread_mutex_lock(pthread_mutex_t *mutex);
+    int     __pthread_mutex_trylock(pthread_mutex_t *mutex);
+    int     __pthread_mutex_unlock(pthread_mutex_t *mutex);
+}
+
+namespace
+{
+    enum trap_t
+    {
+        TRAP_MALLOC,
+        TRAP_CALLOC,
+        TRAP_REALLOC,
+        TRAP_FREE,
+        TRAP_LOCK,
+        TRAP_TRYLOCK,
+        TRAP_UNLOCK,
+
+        TRAP_TOTAL
+    };
+
+    static const char *trap_names[] =
+    {
+        "malloc",
+        "calloc",
+        "realloc",
+        "free",
+        "pthread_mutex_lock",
+        "pthread_mutex_trylock",
+        "pthread_mutex_unlock"
+    };
+
+    // Calls are counted only on the thread which has set the trap
+    static thread_local bool    bTrap           = false;
+    static lsp::atomic_t        vTrapped[TRAP_TOTAL];
+
+    inline void trap(trap_t type)
+    {
+        if (bTrap)
+            lsp::atomic_add(&vTrapped[type], 1);
+    }
+}
+
+extern "C"
+{
+    void *malloc(size_t size) noexcept
+    {
+        trap(TRAP_MALLOC);
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t nmemb, size_t size) noexcept
+    {
+        trap(TRAP_CALLOC);
+        return __libc_calloc(nmemb, size);
+    }
+
+    void *realloc(void *ptr, size_t size) noexcept
+    {
+        trap(TRAP_REALLOC);
+        return __libc_realloc(ptr, size);
+    }
+
+    void free(void *ptr) noexcept
+    {
+        trap(TRAP_FREE);
+        __libc_free(ptr);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t *mutex) noexcept
+    {
+        trap(TRAP_LOCK);
+        return __pthread_mutex_lock(mutex);
+    }
+
+    int pthread_mutex_trylock(pthread_mutex_t *mutex) noexcept
+    {
+        trap(TRAP_TRYLOCK);
+        return __pthread_mutex_trylock(mutex);
+    }
+
+    int pthread_mutex_unlock(pthread_mutex_t *mutex) noexcept
+    {
+        trap(TRAP_UNLOCK);
+        return __pthread_mutex_unlock(mutex);
+    }
+}
+
+#endif /* PLATFORM_LINUX && __GLIBC__ && !LSP_TRACE */
+
+UTEST_BEGIN("plugins.gott_compressor", rt_safety)
+
+#if defined(PLATFORM_LINUX) && defined(__GLIBC__) && !defined(LSP_TRACE)
+    static constexpr size_t BLOCK       = 1024;
+    static constexpr size_t BLOCKS      = 8;
+
+    typedef struct change_t
+    {
+        const char     *id;
+        float           value;
+    } change_t;
+
+    void fill_input(gott_test::Host *host)
+    {
+        for (size_t i=0; i<host->channels(); ++i)
+        {
+            float *in           = host->input(i);
+            for (size_t j=0; j<BLOCK; ++j)
+                in[j]               = 0.5f * sinf(2.0f * M_PI * 220.0f * (i + 1) * j / 48000.0f);
+        }
+        if (host->has_sidechain())
+        {
+            for (size_t i=0; i<host->channels(); ++i)
+                dsp::copy(host->sidechain(i), host->input(i), BLOCK);
+        }
+    }
+
+    // Apply settings and process the audio with the trap set, then run the tasks
+    // submitted by the plugin outside the trap and let process() adopt their results
+    void run_trapped(gott_test::Host *host, const char *what)
+    {
+        size_t before[TRAP_TOTAL];
+        for (size_t i=0; i<TRAP_TOTAL; ++i)
+            before[i]           = lsp::atomic_load(&vTrapped[i]);
+
+        for (size_t pass=0; pass<2; ++pass)
+        {
+            bTrap               = true;
+            host->module()->update_settings();
+            for (size_t i=0; i<BLOCKS; ++i)
+                host->process(BLOCK);
+            bTrap               = false;
+
+            host->run_tasks();
+        }
+
+        for (size_t i=0; i<TRAP_TOTAL; ++i)
+        {
+            const size_t count  = lsp::atomic_load(&vTrapped[i]) - before[i];
+            UTEST_ASSERT_MSG(count == 0, "%s: %s: %d calls of %s from process() or update_settings()",
+                host->module()->metadata()->uid, what, int(count), trap_names[i]);
+        }
+    }
+
+    void call(const meta::plugin_t *meta)
+    {
+        static const change_t changes[] =
+        {
+            { "mode",       0.0f    },
+            { "mode",       2.0f    },
+            { "mode",       1.0f    },
+            { "ebe",        1.0f    },
+            { "be_1",       0.0f    },
+            { "be_1",       1.0f    },
+            { "be_2l",      0.0f    },
+            { "be_2l",      1.0f    },
+            { "be_2m",      0.0f    },
+            { "be_2m",      1.0f    },
+            { "ebe",        0.0f    },
+            { "sf1",        200.0f  },
+            { "sf2",        3000.0f },
+            { "mode",       2.0f    },
+            { "sf1",        80.0f   },
+            { "mode",       0.0f    },
+            { "ssplit",     1.0f    },
+            { "ssplit",     0.0f    },
+            { "vca_grp",    3.0f    },
+            { "vca",        1.0f    },
+            { "vca",        2.0f    },
+            { "vca",        0.0f    },
+            { NULL,         0.0f    }
+        };
+        static const long rates[] = { 44100, 96000, 48000 };
+
+        printf("Testing %s...\n", meta->uid);
+
+        gott_test::Host *host   = gott_test::Host::create(meta, 48000, BLOCK);
+        UTEST_ASSERT(host != NULL);
+        lsp_finally { delete host; };
+
+        fill_input(host);
+        run_trapped(host, "initial state");
+
+        // Sweep the parameters, the ones missing in the plugin are skipped
+        for (const change_t *c = changes; c->id != NULL; ++c)
+        {
+            if (!host->set(c->id, c->value))
+                continue;
+
+            char what[64];
+            snprintf(what, sizeof(what), "%s=%g", c->id, c->value);
+            run_trapped(host, what);
+        }
+
+        // Bypass, the processing is suspended and resumed
+        host->set_bypass(true);
+        run_trapped(host, "bypass on");
+        host->set_bypass(false);
+        run_trapped(host, "bypass off");
+
+        // Sample rate is changed by the host outside of the audio thread
+        for (size_t i=0; i<sizeof(rates)/sizeof(rates[0]); ++i)
+        {
+            host->module()->set_sample_rate(rates[i]);
+            host->run_tasks();
+
+            char what[64];
+            snprintf(what, sizeof(what), "sample_rate=%ld", rates[i]);
+            for (size_t j=0; j<3; ++j)
+            {
+                host->set("mode", j);
+                run_trapped(host, what);
+            }
+        }
+
+        // Paths guarded inside the plugin: locks and allocations without libc calls
+        UTEST_ASSERT_MSG(gott_test::Module::rt_violations() == 0,
+            "%s: %d non-RT-safe calls detected by the plugin", meta->uid, int(gott_test::Module::rt_violations()));
+    }
+#endif /* PLATFORM_LINUX && __GLIBC__ && !LSP_TRACE */
+
+    UTEST_MAIN
+    {
+    #if defined(PLATFORM_LINUX) && defined(__GLIBC__) && !defined(LSP_TRACE)
+        const meta::plugin_t *list[] =
+        {
+            &meta::gott_compressor_mono,
+            &meta::gott_compressor_stereo,
+            &meta::gott_compressor_lr,
+            &meta::gott_compressor_ms,
+            &meta::sc_gott_compressor_mono,
+            &meta::sc_gott_compressor_stereo,
+            &meta::sc_gott_compressor_lr,
+            &meta::sc_gott_compressor_ms
+        };
+
+        for (size_t i=0; i<sizeof(list)/sizeof(list[0]); ++i)
+            call(list[i]);
+    #else
+        printf("The test requires glibc on Linux and a build without trace output, skipping\n");
+    #endif /* PLATFORM_LINUX && __GLIBC__ && !LSP_TRACE */
+    }
+
+UTEST_END
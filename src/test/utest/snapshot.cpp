@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-gott-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-gott-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-gott-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-gott-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include "../helpers/gott_host.h"
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr size_t BLOCK           = 512;
+    static constexpr size_t SAMPLE_RATE     = 48000;
+
+    // Deterministic input of the block: decaying bursts over the noise, the same for all hosts
+    void fill_block(gott_test::Host *host, size_t block)
+    {
+        for (size_t i=0; i<host->channels(); ++i)
+        {
+            float *in           = host->input(i);
+            uint32_t seed       = uint32_t(block * 2 + i + 1) * 0x9e3779b9u;
+            for (size_t j=0; j<BLOCK; ++j)
+            {
+                const size_t t      = block * BLOCK + j;
+                const float env     = expf(-float(t % 9600) / 2400.0f);
+                seed                = seed * 1664525 + 1013904223;
+                in[j]               = 0.8f * env * sinf(2.0f * M_PI * 110.0f * t / SAMPLE_RATE) +
+                                      0.05f * float(int32_t(seed)) / float(0x80000000u);
+            }
+        }
+    }
+}
+
+UTEST_BEGIN("plugins.gott_compressor", snapshot)
+
+    gott_test::Host *create_host()
+    {
+        gott_test::Host *host   = gott_test::Host::create(&meta::gott_compressor_stereo, SAMPLE_RATE, BLOCK);
+        if (host != NULL)
+        {
+            host->set("lkahead", 5.0f);
+            host->commit();
+        }
+        return host;
+    }
+
+    status_t clone_state(gott_test::Host *dst, const uint8_t *data, size_t size, uint32_t bypass_state)
+    {
+        // Patch the bypass state of the snapshot if requested
+        uint8_t *copy           = static_cast<uint8_t *>(malloc(size));
+        if (copy == NULL)
+            return STATUS_NO_MEM;
+        lsp_finally { free(copy); };
+        memcpy(copy, data, size);
+        if (bypass_state != uint32_t(-1))
+        {
+            gott_test::Module::snapshot_header_t hdr;
+            memcpy(&hdr, copy, sizeof(hdr));
+            hdr.nBypassState        = bypass_state;
+            memcpy(copy, &hdr, sizeof(hdr));
+        }
+
+        return dst->module()->restore_snapshot(copy, size);
+    }
+
+    double render(gott_test::Host *host, size_t first, size_t count, const float *ref)
+    {
+        // Return the energy of the difference with the reference
+        double err              = 0.0;
+        for (size_t i=0; i<count; ++i)
+        {
+            fill_block(host, first + i);
+            host->process(BLOCK);
+            for (size_t j=0; j<host->channels(); ++j)
+            {
+                const float *out        = host->output(j);
+                const float *r          = &ref[((i * host->channels()) + j) * BLOCK];
+                for (size_t k=0; k<BLOCK; ++k)
+                    err                    += (out[k] - r[k]) * (out[k] - r[k]);
+            }
+        }
+        return err;
+    }
+
+    UTEST_MAIN
+    {
+        static constexpr size_t WARM_UP     = 200;
+        static constexpr size_t COMPARE     = 40;
+
+        float *ref              = static_cast<float *>(malloc(COMPARE * 2 * BLOCK * sizeof(float)));
+        UTEST_ASSERT(ref != NULL);
+        lsp_finally { free(ref); };
+
+        // Source instance: render the signal and take the snapshot between two blocks
+        gott_test::Host *src    = create_host();
+        UTEST_ASSERT(src != NULL);
+        lsp_finally { delete src; };
+        for (size_t i=0; i<WARM_UP; ++i)
+        {
+            fill_block(src, i);
+            src->process(BLOCK);
+        }
+
+        const size_t size       = src->module()->snapshot_size();
+        UTEST_ASSERT(size >= sizeof(gott_test::Module::snapshot_header_t));
+        uint8_t *data           = static_cast<uint8_t *>(malloc(size));
+        UTEST_ASSERT(data != NULL);
+        lsp_finally { free(data); };
+        UTEST_ASSERT(src->module()->save_snapshot(data, size) == size);
+        UTEST_ASSERT(src->module()->save_snapshot(data, size - 1) == 0);
+
+        for (size_t i=0; i<COMPARE; ++i)
+        {
+            fill_block(src, WARM_UP + i);
+            src->process(BLOCK);
+            for (size_t j=0; j<src->channels(); ++j)
+                dsp::copy(&ref[((i * src->channels()) + j) * BLOCK], src->output(j), BLOCK);
+        }
+
+        // Restored instance should continue the source output closer than the cold one
+        gott_test::Host *dst    = create_host();
+        UTEST_ASSERT(dst != NULL);
+        lsp_finally { delete dst; };
+        UTEST_ASSERT(clone_state(dst, data, size, uint32_t(-1)) == STATUS_OK);
+        const double err_dst    = render(dst, WARM_UP, COMPARE, ref);
+        UTEST_ASSERT(dst->module()->bypass_state() == gott_test::Module::BYP_ACTIVE);
+
+        gott_test::Host *cold   = create_host();
+        UTEST_ASSERT(cold != NULL);
+        lsp_finally { delete cold; };
+        const double err_cold   = render(cold, WARM_UP, COMPARE, ref);
+        printf("Restored error: %g, cold start error: %g\n", err_dst, err_cold);
+        UTEST_ASSERT_MSG(err_dst < err_cold * 0.5, "err_dst=%g, err_cold=%g", err_dst, err_cold);
+
+        // Bypass state of the snapshot is adjusted to the bypass switch of the instance
+        gott_test::Host *byp    = create_host();
+        UTEST_ASSERT(byp != NULL);
+        lsp_finally { delete byp; };
+        UTEST_ASSERT(byp->set_bypass(true));
+        byp->commit();
+        UTEST_ASSERT(clone_state(byp, data, size, gott_test::Module::BYP_ACTIVE) == STATUS_OK);
+        UTEST_ASSERT(byp->module()->bypass_state() == gott_test::Module::BYP_FADE_OUT);
+
+        gott_test::Host *wrm    = create_host();
+        UTEST_ASSERT(wrm != NULL);
+        lsp_finally { delete wrm; };
+        UTEST_ASSERT(clone_state(wrm, data, size, gott_test::Module::BYP_SUSPENDED) == STATUS_OK);
+        UTEST_ASSERT(wrm->module()->bypass_state() == gott_test::Module::BYP_WARM_UP);
+
+        // Snapshot with the invalid bypass state is rejected
+        gott_test::Module::snapshot_header_t hdr;
+        memcpy(&hdr, data, sizeof(hdr));
+        hdr.nBypassState        = 42;
+        memcpy(data, &hdr, sizeof(hdr));
+        UTEST_ASSERT(dst->module()->restore_snapshot(data, size) == STATUS_CORRUPTED);
+    }
+
+UTEST_END